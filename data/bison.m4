@@ -979,6 +979,25 @@ b4_define_flag_if([error_verbose])
 b4_error_verbose_if([m4_define([b4_token_table_flag], [1])])
 
 
+# b4_error_tables_if([IF-ERROR-TABLES-ARE-USED], [IF-NOT])
+# --------------------------------------------------------
+# Whether the expected tokens of the verbose error messages are
+# precomputed (%define parse.error.tables).  Only the skeletons that
+# support it expand this macro, so that the others report the
+# variable as unused.
+b4_percent_define_if_define([error_tables], [parse.error.tables])
+
+# b4_error_tables_check
+# ---------------------
+# Complain if the error tables are requested without verbose errors.
+m4_define([b4_error_tables_check],
+[b4_error_tables_if([b4_error_verbose_if([],
+  [b4_fatal_at(b4_percent_define_get_loc([[parse.error.tables]]),
+               [cannot use '%s' without '%s'],
+               [%define parse.error.tables],
+               [%define parse.error verbose])])])])
+
+
 # b4_variant_if([IF-VARIANT-ARE-USED], [IF-NOT])
 # ----------------------------------------------
 b4_percent_define_if_define([variant])
@@ -53,6 +53,17 @@ b4_percent_define_default([[define_location_comparison]],
                                  [std::string], [[true]], [[false]])])
 
 
+# b4_move_if([IF-VALUES-ARE-MOVED], [IF-NOT])
+# -------------------------------------------
+# Whether the semantic values are moved (C++11) rather than copied.
+b4_percent_define_if_define([move], [api.value.move])
+
+# b4_move(EXPR)
+# -------------
+# EXPR, as an rvalue if the semantic values are moved.
+m4_define([b4_move],
+[b4_move_if([std::move ($1)], [$1])])
+
 
 ## ----------- ##
 ## Namespace.  ##
@@ -189,9 +200,11 @@ m4_define([b4_public_types_declare],
 
       /// Default constructor.
       basic_symbol ();
-
+]b4_move_if([[
+      /// Move constructor, \a other is emptied into this.
+      basic_symbol (basic_symbol&& other);]], [[
       /// Copy constructor.
-      basic_symbol (const basic_symbol& other);
+      basic_symbol (const basic_symbol& other);]])[
 ]b4_variant_if([[
       /// Constructor for valueless symbols, and symbols from each type.
 ]b4_type_foreach([b4_basic_symbol_constructor_declare])], [[
@@ -276,7 +289,12 @@ m4_define([b4_public_types_define],
   {}
 
   template <typename Base>
-  inline
+  inline]b4_move_if([[
+  ]b4_parser_class_name[::basic_symbol<Base>::basic_symbol (basic_symbol&& other)
+    : value ()
+  {
+    move (other);
+  }]], [[
   ]b4_parser_class_name[::basic_symbol<Base>::basic_symbol (const basic_symbol& other)
     : Base (other)
     , value ()]b4_locations_if([
@@ -285,7 +303,7 @@ m4_define([b4_public_types_define],
     ]b4_variant_if([b4_symbol_variant([other.type_get ()], [value], [copy],
                                       [other.value])],
                    [value = other.value;])[
-  }
+  }]])[
 
 
   template <typename Base>
@@ -537,6 +555,12 @@ m4_define([b4_yylloc_default_define],
 ## Checks.  ##
 ## -------- ##
 
+b4_move_if([b4_variant_if([],
+  [b4_fatal_at(b4_percent_define_get_loc(api.value.move),
+               [cannot use '%s' without '%s'],
+               [%define api.value.move],
+               [%define api.value.type variant]))])])
+
 b4_token_ctor_if([b4_variant_if([],
   [b4_fatal_at(b4_percent_define_get_loc(api.token.constructor),
                [cannot use '%s' without '%s'],
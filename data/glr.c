@@ -31,6 +31,15 @@ m4_if(b4_skeleton, ["glr.c"],
 m4_define_default([b4_stack_depth_max], [10000])
 m4_define_default([b4_stack_depth_init],  [200])
 
+# Stack layout: in segmented mode, the stack grows by chaining new
+# segments, and its items never move.
+b4_percent_define_default([[parse.stack]], [[contiguous]])
+b4_percent_define_check_values([[[[parse.stack]],
+                                  [[contiguous]], [[segmented]]]])
+b4_define_flag_if([segmented])
+m4_define([b4_segmented_flag],
+          [m4_if(b4_percent_define_get([[parse.stack]]),
+                 [segmented], [[1]], [[0]])])
 
 
 ## ------------------------ ##
@@ -471,7 +480,11 @@ static void yypdumpstack (struct yyGLRStack* yystackp)
 #ifndef YYMAXDEPTH
 # define YYMAXDEPTH ]b4_stack_depth_max[
 #endif
-
+]b4_segmented_if([[
+/* YYINITSTATESET -- number of stacks before the parser allocates
+   their set.  */
+#define YYINITSTATESET 16
+]])[
 /* Minimum number of free items on the stack allowed after an
    allocation.  This is to allow allocation and initialization
    to be completed by functions that call yyexpandGLRStack before the
@@ -585,7 +598,8 @@ typedef short int yyItemNum;
 typedef struct yyGLRState yyGLRState;
 typedef struct yyGLRStateSet yyGLRStateSet;
 typedef struct yySemanticOption yySemanticOption;
-typedef union yyGLRStackItem yyGLRStackItem;
+typedef union yyGLRStackItem yyGLRStackItem;]b4_segmented_if([[
+typedef struct yyGLRStackSegment yyGLRStackSegment;]])[
 typedef struct yyGLRStack yyGLRStack;
 
 struct yyGLRState {
@@ -619,7 +633,12 @@ struct yyGLRStateSet {
    *  operation, yylookaheadNeeds[0] is not maintained since it would merely
    *  duplicate yychar != YYEMPTY.  */
   yybool* yylookaheadNeeds;
-  size_t yysize, yycapacity;
+  size_t yysize, yycapacity;]b4_segmented_if([[
+  /** The storage of yystates and yylookaheadNeeds until the stack is
+   *  split more than YYINITSTATESET times, so that starting a parse does
+   *  not allocate them.  */
+  yyGLRState* yyinitStates[YYINITSTATESET];
+  yybool yyinitLookaheadNeeds[YYINITSTATESET];]])[
 };
 
 struct yySemanticOption {
@@ -644,6 +663,22 @@ union yyGLRStackItem {
   yyGLRState yystate;
   yySemanticOption yyoption;
 };
+]b4_segmented_if([[
+/** A block of items of the GLR stack.  The stack grows by chaining new
+ *  segments, so its items are never moved.  The segments after the
+ *  current one are spare, ready to be reused.  */
+struct yyGLRStackSegment {
+  yyGLRStackSegment* yyprev;
+  yyGLRStackSegment* yynext;
+  /** Index in the whole stack of the first item of this segment.  */
+  size_t yystart;
+  /** Number of items of this segment.  */
+  size_t yysize;
+  /** Number of items in use, if this is not the current segment.  */
+  size_t yyused;
+  yyGLRStackItem yyitems[1];
+};
+]])[
 
 struct yyGLRStack {
   int yyerrState;
@@ -657,7 +692,9 @@ struct yyGLRStack {
   YYLTYPE yyloc;]])[
 ])[
   YYJMP_BUF yyexception_buffer;
-  yyGLRStackItem* yyitems;
+  yyGLRStackItem* yyitems;]b4_segmented_if([[
+  /** The segment of yynextFree.  yyitems are those of the first one.  */
+  yyGLRStackSegment* yysegment;]])[
   yyGLRStackItem* yynextFree;
   size_t yyspaceLeft;
   yyGLRState* yysplitPoint;
@@ -742,20 +779,22 @@ yyfill (yyGLRStackItem *yyvsp, int *yylow, int yylow1, yybool yynormal)
 }
 
 /** Perform user action for rule number YYN, with RHS length YYRHSLEN,
- *  and top stack item YYVSP.  YYLVALP points to place to put semantic
+ *  and top stack item YYVSP.  YYNORMAL is true if the items below
+ *  YYVSP are those of the stack, and false if YYVSP points into a copy
+ *  that is filled on demand.  YYLVALP points to place to put semantic
  *  value ($$), and yylocp points to place for location information
  *  (@@$).  Returns yyok for normal return, yyaccept for YYACCEPT,
  *  yyerr for YYERROR, yyabort for YYABORT.  */
 static YYRESULTTAG
 yyuserAction (yyRuleNum yyn, size_t yyrhslen, yyGLRStackItem* yyvsp,
-              yyGLRStack* yystackp,
+              yybool yynormal, yyGLRStack* yystackp,
               YYSTYPE* yyvalp]b4_locuser_formals[)
 {
-  yybool yynormal __attribute__ ((__unused__)) =
-    (yystackp->yysplitPoint == YY_NULL);
   int yylow;
 ]b4_parse_param_use([yyvalp], [yylocp])dnl
 [  YYUSE (yyrhslen);
+  YYUSE (yynormal);
+  YYUSE (yystackp);
 # undef yyerrok
 # define yyerrok (yystackp->yyerrState = 0)
 # undef YYACCEPT
@@ -988,7 +1027,11 @@ yyaddDeferredAction (yyGLRStack* yystackp, size_t yyk, yyGLRState* yystate,
 static yybool
 yyinitStateSet (yyGLRStateSet* yyset)
 {
-  yyset->yysize = 1;
+  yyset->yysize = 1;]b4_segmented_if([[
+  yyset->yycapacity = YYINITSTATESET;
+  yyset->yystates = yyset->yyinitStates;
+  yyset->yystates[0] = YY_NULL;
+  yyset->yylookaheadNeeds = yyset->yyinitLookaheadNeeds;]], [[
   yyset->yycapacity = 16;
   yyset->yystates = (yyGLRState**) YYMALLOC (16 * sizeof yyset->yystates[0]);
   if (! yyset->yystates)
@@ -1000,16 +1043,68 @@ yyinitStateSet (yyGLRStateSet* yyset)
     {
       YYFREE (yyset->yystates);
       return yyfalse;
-    }
+    }]])[
   return yytrue;
 }
 
 static void yyfreeStateSet (yyGLRStateSet* yyset)
-{
+{]b4_segmented_if([[
+  if (yyset->yystates != yyset->yyinitStates)
+    YYFREE (yyset->yystates);
+  if (yyset->yylookaheadNeeds != yyset->yyinitLookaheadNeeds)
+    YYFREE (yyset->yylookaheadNeeds);]], [[
   YYFREE (yyset->yystates);
-  YYFREE (yyset->yylookaheadNeeds);
+  YYFREE (yyset->yylookaheadNeeds);]])[
+}
+]b4_segmented_if([[
+/** Resize YYP, an array of YYOLDSIZE bytes, to YYSIZE bytes, as
+ *  YYREALLOC, unless it is YYINIT, which is not heap allocated.  */
+static void*
+yyresizeStateSetArray (void* yyp, void* yyinit, size_t yyoldsize,
+                       size_t yysize)
+{
+  void* yyres;
+  if (yyp != yyinit)
+    return YYREALLOC (yyp, yysize);
+  yyres = YYMALLOC (yysize);
+  if (yyres)
+    memcpy (yyres, yyp, yyoldsize);
+  return yyres;
+}
+]])[
+]b4_segmented_if([[
+/** Allocate a segment of YYSIZE items, and chain it after YYPREV if
+ *  it is not null.  Return null if memory is exhausted.  */
+static yyGLRStackSegment*
+yynewGLRStackSegment (yyGLRStackSegment* yyprev, size_t yysize)
+{
+  yyGLRStackSegment* yyseg =
+    (yyGLRStackSegment*) YYMALLOC (sizeof *yyseg
+                                   + (yysize - 1) * sizeof yyseg->yyitems[0]);
+  if (! yyseg)
+    return YY_NULL;
+  yyseg->yyprev = yyprev;
+  yyseg->yynext = YY_NULL;
+  yyseg->yystart = yyprev ? yyprev->yystart + yyprev->yysize : 0;
+  yyseg->yysize = yysize;
+  yyseg->yyused = 0;
+  if (yyprev)
+    yyprev->yynext = yyseg;
+  return yyseg;
 }
 
+/** Free YYSEG and the segments after it.  */
+static void
+yyfreeGLRStackSegments (yyGLRStackSegment* yyseg)
+{
+  while (yyseg)
+    {
+      yyGLRStackSegment* yynext = yyseg->yynext;
+      YYFREE (yyseg);
+      yyseg = yynext;
+    }
+}
+]])[
 /** Initialize *YYSTACKP to a single empty stack, with total maximum
  *  capacity for all stacks of YYSIZE.  */
 static yybool
@@ -1017,9 +1112,12 @@ yyinitGLRStack (yyGLRStack* yystackp, size_t yysize)
 {
   yystackp->yyerrState = 0;
   yynerrs = 0;
-  yystackp->yyspaceLeft = yysize;
+  yystackp->yyspaceLeft = yysize;]b4_segmented_if([[
+  yystackp->yysegment = yynewGLRStackSegment (YY_NULL, yysize);
   yystackp->yyitems =
-    (yyGLRStackItem*) YYMALLOC (yysize * sizeof yystackp->yynextFree[0]);
+    yystackp->yysegment ? yystackp->yysegment->yyitems : YY_NULL;]], [[
+  yystackp->yyitems =
+    (yyGLRStackItem*) YYMALLOC (yysize * sizeof yystackp->yynextFree[0]);]])[
   if (!yystackp->yyitems)
     return yyfalse;
   yystackp->yynextFree = yystackp->yyitems;
@@ -1029,7 +1127,29 @@ yyinitGLRStack (yyGLRStack* yystackp, size_t yysize)
 }
 
 
-#if YYSTACKEXPANDABLE
+#if YYSTACKEXPANDABLE]b4_segmented_if([[
+/** Extend *YYSTACKP with its next segment, allocating it if needed.
+    The items are not moved, so pointers into the stack remain valid.
+    The size of the stack is doubled at each allocation.  */
+static void
+yyexpandGLRStack (yyGLRStack* yystackp)
+{
+  yyGLRStackSegment* yyseg = yystackp->yysegment;
+  yyseg->yyused = yystackp->yynextFree - yyseg->yyitems;
+  if (! yyseg->yynext)
+    {
+      size_t yysize = yyseg->yystart + yyseg->yysize;
+      if (YYMAXDEPTH - YYHEADROOM < yysize)
+        yyMemoryExhausted (yystackp);
+      if (! yynewGLRStackSegment (yyseg, (YYMAXDEPTH - yysize < yysize
+                                          ? YYMAXDEPTH - yysize : yysize)))
+        yyMemoryExhausted (yystackp);
+    }
+  yyseg = yyseg->yynext;
+  yystackp->yysegment = yyseg;
+  yystackp->yynextFree = yyseg->yyitems;
+  yystackp->yyspaceLeft = yyseg->yysize;
+}]], [[
 # define YYRELOC(YYFROMITEMS,YYTOITEMS,YYX,YYTYPE) \
   &((YYTOITEMS) - ((YYFROMITEMS) - (yyGLRStackItem*) (YYX)))->YYTYPE
 
@@ -1093,15 +1213,69 @@ yyexpandGLRStack (yyGLRStack* yystackp)
   yystackp->yyitems = yynewItems;
   yystackp->yynextFree = yynewItems + yysize;
   yystackp->yyspaceLeft = yynewSize - yysize;
-}
+}]])[
 #endif
 
 static void
 yyfreeGLRStack (yyGLRStack* yystackp)
-{
-  YYFREE (yystackp->yyitems);
+{]b4_segmented_if([[
+  yyGLRStackSegment* yyseg = yystackp->yysegment;
+  while (yyseg->yyprev)
+    yyseg = yyseg->yyprev;
+  yyfreeGLRStackSegments (yyseg);]], [[
+  YYFREE (yystackp->yyitems);]])[
   yyfreeStateSet (&yystackp->yytops);
 }
+]b4_segmented_if([[
+/** The index of YYP, a live item of *YYSTACKP, in the whole stack.  The
+ *  items are numbered in the order of their allocation.  */
+static size_t
+yyitemIndex (yyGLRStack* yystackp, void* yyp)
+{
+  yyGLRStackItem* yyitem = (yyGLRStackItem*) yyp;
+  yyGLRStackSegment* yyseg = yystackp->yysegment;
+  while (! (yyseg->yyitems <= yyitem
+            && yyitem < yyseg->yyitems + yyseg->yysize))
+    yyseg = yyseg->yyprev;
+  return yyseg->yystart + (yyitem - yyseg->yyitems);
+}
+
+/** Make YYS, a state of the deterministic stack of *YYSTACKP, or the
+ *  bottom of the stack if YYS is null, the last item of *YYSTACKP.
+ *  The items above it are released.  */
+static void
+yyrewindGLRStack (yyGLRStack* yystackp, yyGLRState* yys)
+{
+  yyGLRStackItem* yyitem = (yyGLRStackItem*) yys;
+  yyGLRStackSegment* yyseg = yystackp->yysegment;
+  if (yyitem)
+    {
+      while (! (yyseg->yyitems <= yyitem
+                && yyitem < yyseg->yyitems + yyseg->yysize))
+        yyseg = yyseg->yyprev;
+      yystackp->yynextFree = yyitem + 1;
+    }
+  else
+    {
+      while (yyseg->yyprev)
+        yyseg = yyseg->yyprev;
+      yystackp->yynextFree = yyseg->yyitems;
+    }
+  yystackp->yysegment = yyseg;
+  yystackp->yyspaceLeft =
+    yyseg->yysize - (yystackp->yynextFree - yyseg->yyitems);
+  YY_RESERVE_GLRSTACK (yystackp);
+}
+]])[
+/** Whether the item YYP0 of *YYSTACKP was allocated after the item
+ *  YYP1.  */
+static inline yybool
+yyitemAfter (yyGLRStack* yystackp, void* yyp0, void* yyp1)
+{]b4_segmented_if([[
+  return yyitemIndex (yystackp, yyp0) > yyitemIndex (yystackp, yyp1);]], [[
+  YYUSE (yystackp);
+  return (yyGLRStackItem*) yyp0 > (yyGLRStackItem*) yyp1;]])[
+}
 
 /** Assuming that YYS is a GLRState somewhere on *YYSTACKP, update the
  *  splitpoint of *YYSTACKP, if needed, so that it is at least as deep as
@@ -1109,7 +1283,8 @@ yyfreeGLRStack (yyGLRStack* yystackp)
 static inline void
 yyupdateSplit (yyGLRStack* yystackp, yyGLRState* yys)
 {
-  if (yystackp->yysplitPoint != YY_NULL && yystackp->yysplitPoint > yys)
+  if (yystackp->yysplitPoint != YY_NULL
+      && yyitemAfter (yystackp, yystackp->yysplitPoint, yys))
     yystackp->yysplitPoint = yys;
 }
 
@@ -1264,9 +1439,16 @@ static inline YYRESULTTAG
 yydoAction (yyGLRStack* yystackp, size_t yyk, yyRuleNum yyrule,
             YYSTYPE* yyvalp]b4_locuser_formals[)
 {
-  int yynrhs = yyrhsLength (yyrule);
-
-  if (yystackp->yysplitPoint == YY_NULL)
+  int yynrhs = yyrhsLength (yyrule);]b4_segmented_if([[
+  yyGLRStackItem* yytop = (yyGLRStackItem*) yystackp->yytops.yystates[yyk];
+  yyGLRStackSegment* yyseg = yystackp->yysegment;]])[
+
+  if (yystackp->yysplitPoint == YY_NULL]b4_segmented_if([[
+      /* The symbols, and those before them that the action may refer
+         to, must be contiguous on the stack.  */
+      && yytop + 1 == yystackp->yynextFree
+      && (yyseg->yyprev == YY_NULL
+          || yynrhs + YYMAXLEFT <= yytop - yyseg->yyitems)]])[)
     {
       /* Standard special case: single stack.  */
       yyGLRStackItem* yyrhs = (yyGLRStackItem*) yystackp->yytops.yystates[yyk];
@@ -1275,7 +1457,7 @@ yydoAction (yyGLRStack* yystackp, size_t yyk, yyRuleNum yyrule,
       yystackp->yyspaceLeft += yynrhs;
       yystackp->yytops.yystates[0] = & yystackp->yynextFree[-1].yystate;
       YY_REDUCE_PRINT ((1, yyrhs, yyk, yyrule]b4_user_args[));
-      return yyuserAction (yyrule, yynrhs, yyrhs, yystackp,
+      return yyuserAction (yyrule, yynrhs, yyrhs, yytrue, yystackp,
                            yyvalp]b4_locuser_args[);
     }
   else
@@ -1294,10 +1476,12 @@ yydoAction (yyGLRStack* yystackp, size_t yyk, yyRuleNum yyrule,
           YYASSERT (yys);
         }
       yyupdateSplit (yystackp, yys);
-      yystackp->yytops.yystates[yyk] = yys;
+      yystackp->yytops.yystates[yyk] = yys;]b4_segmented_if([[
+      if (yystackp->yysplitPoint == YY_NULL)
+        yyrewindGLRStack (yystackp, yys);]])[
       YY_REDUCE_PRINT ((0, yyrhsVals + YYMAXRHS + YYMAXLEFT - 1, yyk, yyrule]b4_user_args[));
       return yyuserAction (yyrule, yynrhs, yyrhsVals + YYMAXRHS + YYMAXLEFT - 1,
-                           yystackp, yyvalp]b4_locuser_args[);
+                           yyfalse, yystackp, yyvalp]b4_locuser_args[);
     }
 }
 
@@ -1403,7 +1587,12 @@ yysplitStack (yyGLRStack* yystackp, size_t yyk)
       yystackp->yytops.yycapacity *= 2;
 
       yynewStates =
-        (yyGLRState**) YYREALLOC (yystackp->yytops.yystates,
+        (yyGLRState**) ]b4_segmented_if([[yyresizeStateSetArray (
+                                  yystackp->yytops.yystates,
+                                  yystackp->yytops.yyinitStates,
+                                  (yystackp->yytops.yysize
+                                   * sizeof yynewStates[0]),]],
+                                  [[YYREALLOC (yystackp->yytops.yystates,]])[
                                   (yystackp->yytops.yycapacity
                                    * sizeof yynewStates[0]));
       if (yynewStates == YY_NULL)
@@ -1411,7 +1600,12 @@ yysplitStack (yyGLRStack* yystackp, size_t yyk)
       yystackp->yytops.yystates = yynewStates;
 
       yynewLookaheadNeeds =
-        (yybool*) YYREALLOC (yystackp->yytops.yylookaheadNeeds,
+        (yybool*) ]b4_segmented_if([[yyresizeStateSetArray (
+                             yystackp->yytops.yylookaheadNeeds,
+                             yystackp->yytops.yyinitLookaheadNeeds,
+                             (yystackp->yytops.yysize
+                              * sizeof yynewLookaheadNeeds[0]),]],
+                             [[YYREALLOC (yystackp->yytops.yylookaheadNeeds,]])[
                              (yystackp->yytops.yycapacity
                               * sizeof yynewLookaheadNeeds[0]));
       if (yynewLookaheadNeeds == YY_NULL)
@@ -1451,7 +1645,8 @@ yyidenticalOptions (yySemanticOption* yyy0, yySemanticOption* yyy1)
 /** Assuming identicalOptions (YYY0,YYY1), destructively merge the
  *  alternative semantic values for the RHS-symbols of YYY1 and YYY0.  */
 static void
-yymergeOptionSets (yySemanticOption* yyy0, yySemanticOption* yyy1)
+yymergeOptionSets (yyGLRStack* yystackp,
+                   yySemanticOption* yyy0, yySemanticOption* yyy1)
 {
   yyGLRState *yys0, *yys1;
   int yyn;
@@ -1485,7 +1680,7 @@ yymergeOptionSets (yySemanticOption* yyy0, yySemanticOption* yyy1)
                   *yyz0p = yyz1;
                   break;
                 }
-              else if (*yyz0p < yyz1)
+              else if (yyitemAfter (yystackp, yyz1, *yyz0p))
                 {
                   yySemanticOption* yyz = *yyz0p;
                   *yyz0p = yyz1;
@@ -1580,7 +1775,7 @@ yyresolveAction (yySemanticOption* yyopt, yyGLRStack* yystackp,
     yylval = yyopt->yyval;]b4_locations_if([
     yylloc = yyopt->yyloc;])[
     yyflag = yyuserAction (yyopt->yyrule, yynrhs,
-                           yyrhsVals + YYMAXRHS + YYMAXLEFT - 1,
+                           yyrhsVals + YYMAXRHS + YYMAXLEFT - 1, yyfalse,
                            yystackp, yyvalp]b4_locuser_args[);
     yychar = yychar_current;
     yylval = yylval_current;]b4_locations_if([
@@ -1737,7 +1932,7 @@ yyresolveValue (yyGLRState* yys, yyGLRStack* yystackp]b4_user_formals[)
 
       if (yyidenticalOptions (yybest, yyp))
         {
-          yymergeOptionSets (yybest, yyp);
+          yymergeOptionSets (yystackp, yybest, yyp);
           *yypp = yyp->yynext;
         }
       else
@@ -1834,22 +2029,40 @@ yycompressStack (yyGLRStack* yystackp)
        yyp != yystackp->yysplitPoint;
        yyr = yyp, yyp = yyq, yyq = yyp->yypred)
     yyp->yypred = yyr;
-
+]b4_segmented_if([[
+  /* Release everything above the split point: the states of the
+     deleted stacks, and the semantic options, all resolved by now.  */
+  yyrewindGLRStack (yystackp, yystackp->yysplitPoint);]], [[
   yystackp->yyspaceLeft += yystackp->yynextFree - yystackp->yyitems;
   yystackp->yynextFree = ((yyGLRStackItem*) yystackp->yysplitPoint) + 1;
-  yystackp->yyspaceLeft -= yystackp->yynextFree - yystackp->yyitems;
+  yystackp->yyspaceLeft -= yystackp->yynextFree - yystackp->yyitems;]])[
   yystackp->yysplitPoint = YY_NULL;
   yystackp->yylastDeleted = YY_NULL;
 
   while (yyr != YY_NULL)
-    {
+    {]b4_segmented_if([[
+      /* The last item of a segment is never a state, so each state is
+         copied at or below its current place.  */
+      yyGLRState* yys = &yynewGLRStackItem (yystackp, yytrue)->yystate;
+      *yys = *yyr;
+      yyr = yyr->yypred;
+      yys->yypred = yyp;
+      yystackp->yytops.yystates[0] = yyp = yys;
+      YY_RESERVE_GLRSTACK (yystackp);]], [[
       yystackp->yynextFree->yystate = *yyr;
       yyr = yyr->yypred;
       yystackp->yynextFree->yystate.yypred = &yystackp->yynextFree[-1].yystate;
       yystackp->yytops.yystates[0] = &yystackp->yynextFree->yystate;
       yystackp->yynextFree += 1;
-      yystackp->yyspaceLeft -= 1;
-    }
+      yystackp->yyspaceLeft -= 1;]])[
+    }]b4_segmented_if([[
+
+  /* Keep a single spare segment.  */
+  if (yystackp->yysegment->yynext)
+    {
+      yyfreeGLRStackSegments (yystackp->yysegment->yynext->yynext);
+      yystackp->yysegment->yynext->yynext = YY_NULL;
+    }]])[
 }
 
 static YYRESULTTAG
@@ -2196,9 +2409,10 @@ yyrecoverSyntaxError (yyGLRStack* yystackp]b4_user_formals[)
       yystackp->yyerror_range[1].yystate.yyloc = yys->yyloc;]])[
       if (yys->yypred != YY_NULL)
         yydestroyGLRState ("Error: popping", yys]b4_user_args[);
-      yystackp->yytops.yystates[0] = yys->yypred;
+      yystackp->yytops.yystates[0] = yys->yypred;]b4_segmented_if([[
+      yyrewindGLRStack (yystackp, yys->yypred);]], [[
       yystackp->yynextFree -= 1;
-      yystackp->yyspaceLeft += 1;
+      yystackp->yyspaceLeft += 1;]])[
     }
   if (yystackp->yytops.yystates[0] == YY_NULL)
     yyFail (yystackp][]b4_lpure_args[, YY_NULL);
@@ -2446,9 +2660,9 @@ b4_dollar_popdef])[]dnl
 ]b4_locations_if([[                 yystack.yyerror_range[1].yystate.yyloc = yys->yyloc;]]
 )[                  if (yys->yypred != YY_NULL)
                       yydestroyGLRState ("Cleanup: popping", yys]b4_user_args[);
-                    yystates[yyk] = yys->yypred;
+                    yystates[yyk] = yys->yypred;]b4_segmented_if([], [[
                     yystack.yynextFree -= 1;
-                    yystack.yyspaceLeft += 1;
+                    yystack.yyspaceLeft += 1;]])[
                   }
                 break;
               }
@@ -2489,39 +2703,57 @@ yypstack (yyGLRStack* yystackp, size_t yyk)
   yypstates (yystackp->yytops.yystates[yyk]);
 }
 
+]b4_segmented_if([[
+#define YYINDEX(YYX)                                                         \
+    ((YYX) == YY_NULL ? -1 : (long int) yyitemIndex (yystackp, (YYX)))]], [[
 #define YYINDEX(YYX)                                                         \
-    ((YYX) == YY_NULL ? -1 : (yyGLRStackItem*) (YYX) - yystackp->yyitems)
+    ((YYX) == YY_NULL ? -1 : (yyGLRStackItem*) (YYX) - yystackp->yyitems)]])[
 
+static void
+yypdumpitem (yyGLRStack* yystackp, yyGLRStackItem* yyp)
+{
+  YYFPRINTF (stderr, "%3lu. ", (unsigned long int) YYINDEX (yyp));
+  if (*(yybool *) yyp)
+    {
+      YYFPRINTF (stderr, "Res: %d, LR State: %d, posn: %lu, pred: %ld",
+                 yyp->yystate.yyresolved, yyp->yystate.yylrState,
+                 (unsigned long int) yyp->yystate.yyposn,
+                 (long int) YYINDEX (yyp->yystate.yypred));
+      if (! yyp->yystate.yyresolved)
+        YYFPRINTF (stderr, ", firstVal: %ld",
+                   (long int) YYINDEX (yyp->yystate
+                                         .yysemantics.yyfirstVal));
+    }
+  else
+    {
+      YYFPRINTF (stderr, "Option. rule: %d, state: %ld, next: %ld",
+                 yyp->yyoption.yyrule - 1,
+                 (long int) YYINDEX (yyp->yyoption.yystate),
+                 (long int) YYINDEX (yyp->yyoption.yynext));
+    }
+  YYFPRINTF (stderr, "\n");
+}
 
 static void
 yypdumpstack (yyGLRStack* yystackp)
 {
   yyGLRStackItem* yyp;
-  size_t yyi;
-  for (yyp = yystackp->yyitems; yyp < yystackp->yynextFree; yyp += 1)
+  size_t yyi;]b4_segmented_if([[
+  yyGLRStackSegment* yyseg = yystackp->yysegment;
+  while (yyseg->yyprev)
+    yyseg = yyseg->yyprev;
+  for (;; yyseg = yyseg->yynext)
     {
-      YYFPRINTF (stderr, "%3lu. ",
-                 (unsigned long int) (yyp - yystackp->yyitems));
-      if (*(yybool *) yyp)
-        {
-          YYFPRINTF (stderr, "Res: %d, LR State: %d, posn: %lu, pred: %ld",
-                     yyp->yystate.yyresolved, yyp->yystate.yylrState,
-                     (unsigned long int) yyp->yystate.yyposn,
-                     (long int) YYINDEX (yyp->yystate.yypred));
-          if (! yyp->yystate.yyresolved)
-            YYFPRINTF (stderr, ", firstVal: %ld",
-                       (long int) YYINDEX (yyp->yystate
-                                             .yysemantics.yyfirstVal));
-        }
-      else
-        {
-          YYFPRINTF (stderr, "Option. rule: %d, state: %ld, next: %ld",
-                     yyp->yyoption.yyrule - 1,
-                     (long int) YYINDEX (yyp->yyoption.yystate),
-                     (long int) YYINDEX (yyp->yyoption.yynext));
-        }
-      YYFPRINTF (stderr, "\n");
-    }
+      yyGLRStackItem* yyend =
+        (yyseg == yystackp->yysegment
+         ? yystackp->yynextFree : yyseg->yyitems + yyseg->yyused);
+      for (yyp = yyseg->yyitems; yyp < yyend; yyp += 1)
+        yypdumpitem (yystackp, yyp);
+      if (yyseg == yystackp->yysegment)
+        break;
+    }]], [[
+  for (yyp = yystackp->yyitems; yyp < yystackp->yynextFree; yyp += 1)
+    yypdumpitem (yystackp, yyp);]])[
   YYFPRINTF (stderr, "Tops:");
   for (yyi = 0; yyi < yystackp->yytops.yysize; yyi += 1)
     YYFPRINTF (stderr, "%lu: %ld; ", (unsigned long int) yyi,
@@ -17,9 +17,44 @@
 
 m4_include(b4_pkgdatadir/[c++.m4])
 
+# Check the value of %define api.push-pull.
+b4_percent_define_default([[api.push-pull]], [[pull]])
+b4_percent_define_check_values([[[[api.push-pull]],
+                                 [[pull]], [[push]], [[both]]]])
+b4_define_flag_if([pull]) m4_define([b4_pull_flag], [[1]])
+b4_define_flag_if([push]) m4_define([b4_push_flag], [[1]])
+m4_case(b4_percent_define_get([[api.push-pull]]),
+        [pull], [m4_define([b4_push_flag], [[0]])],
+        [push], [m4_define([b4_pull_flag], [[0]])])
+
+# Check the use of %define parse.error.tables.
+b4_error_tables_check
+
 # api.value.type=variant is valid.
 m4_define([b4_value_type_setup_variant])
 
+# Check %define parse.stack.capacity: the stack must hold at least one
+# symbol in place.
+b4_percent_define_ifdef([[parse.stack.capacity]],
+[m4_bmatch(b4_percent_define_get([[parse.stack.capacity]]),
+           [^[1-9][0-9]*$], [],
+  [b4_complain_at(b4_percent_define_get_loc([[parse.stack.capacity]]),
+                  [[invalid value for %%define variable '%s': '%s']],
+                  [[parse.stack.capacity]],
+                  m4_dquote(b4_percent_define_get([[parse.stack.capacity]])))
+   b4_error([[note]], b4_percent_define_get_loc([[parse.stack.capacity]]), []
+            [[accepted value: a positive integer]])])])
+
+# b4_stack_container
+# ------------------
+# With %define parse.stack.capacity N, the container of the parser
+# stack, preceded by a comma: the stack then holds its first N symbols
+# in place.
+m4_define([b4_stack_container],
+[b4_percent_define_ifdef([[parse.stack.capacity]],
+[[, small_vector<stack_symbol_type, ]dnl
+b4_percent_define_get([[parse.stack.capacity]])[> ]])])
+
 # b4_integral_parser_table_declare(TABLE-NAME, CONTENT, COMMENT)
 # --------------------------------------------------------------
 # Declare "parser::yy<TABLE-NAME>_" whose contents is CONTENT.
@@ -151,6 +186,8 @@ m4_define([b4_shared_declarations],
 ]b4_parse_assert_if([# include <cassert>])[
 # include <vector>
 # include <iostream>
+# include <iterator>
+# include <new>
 # include <stdexcept>
 # include <string>]b4_defines_if([[
 # include "stack.hh"
@@ -176,11 +213,20 @@ b4_location_define])])[
     /// Build a parser object.
     ]b4_parser_class_name[ (]b4_parse_param_decl[);
     virtual ~]b4_parser_class_name[ ();
-
+]b4_pull_if([[
     /// Parse.
     /// \returns  0 iff parsing succeeded.
     virtual int parse ();
-
+]])b4_push_if([[
+    /// Value returned by push when more tokens are needed.
+    enum { push_more = 4 };
+
+    /// Push the next token, and run the parser until it needs another.
+    /// \param yysym  the token, emptied by the parser.
+    /// \returns  0 iff parsing succeeded, 1 iff it failed, push_more
+    ///           if more tokens are needed.
+    virtual int push (symbol_type yysym);
+]])[
 #if ]b4_api_PREFIX[DEBUG
     /// The current debugging stream.
     std::ostream& debug_stream () const;
@@ -207,7 +253,19 @@ b4_location_define])])[
     /// This class is not copyable.
     ]b4_parser_class_name[ (const ]b4_parser_class_name[&);
     ]b4_parser_class_name[& operator= (const ]b4_parser_class_name[&);
-
+]b4_push_if([[
+    /// Run the parser.
+    /// \param yypushed  the token pushed by the user, or null to call
+    ///                  the scanner.
+    int yyparse_ (symbol_type* yypushed);
+
+    /// Whether the next push starts a new parse.
+    bool yynew_;
+
+    // Error handling, preserved between pushes.
+    int yynerrs_;
+    int yyerrstatus_;
+]])[
     /// State numbers.
     typedef int state_type;
 
@@ -237,7 +295,23 @@ b4_location_define])])[
     static token_number_type yytranslate_ (]b4_token_ctor_if([token_type], [int])[ t);
 
     // Tables.
-]b4_parser_tables_declare[]b4_error_verbose_if([
+]b4_parser_tables_declare[]b4_error_tables_if([
+b4_integral_parser_table_declare([expected_base], [b4_expected_base],
+     [[YYEXPECTED_BASE[STATE-NUM] -- Index in YYEXPECTED of the tokens
+reported as expected in the error messages in STATE-NUM.]])
+
+b4_integral_parser_table_declare([expected_count], [b4_expected_count],
+     [[YYEXPECTED_COUNT[STATE-NUM] -- Number of these tokens, 0 if there
+are too many to be reported.]])
+
+b4_integral_parser_table_declare([expected], [b4_expected],
+     [[YYEXPECTED -- The expected tokens of all the states, shared
+between them.]])
+
+b4_integral_parser_table_declare([tname_size], [b4_tname_size],
+     [[YYTNAME_SIZE[SYMBOL-NUM] -- Size of the name of the token
+SYMBOL-NUM in the error messages, as computed by yytnamerr_.]])
+])b4_error_verbose_if([
 
     /// Convert the symbol name \a n to a form suitable for a diagnostic.
     static std::string yytnamerr_ (const char *n);])[
@@ -308,15 +382,17 @@ b4_location_define])])[
       /// Construct an empty symbol.
       stack_symbol_type ();
       /// Steal the contents from \a sym to build this.
-      stack_symbol_type (state_type s, symbol_type& sym);
+      stack_symbol_type (state_type s, symbol_type& sym);]b4_move_if([[
+      /// Steal the contents of \a that, needed by push_back.
+      stack_symbol_type (stack_symbol_type&& that);]], [[
       /// Assignment, needed by push_back.
-      stack_symbol_type& operator= (const stack_symbol_type& that);
+      stack_symbol_type& operator= (const stack_symbol_type& that);]])[
     };
 
     /// Stack type.
-    typedef stack<stack_symbol_type> stack_type;
+    typedef stack<stack_symbol_type]b4_stack_container[> stack_type;
 
-    /// The stack.
+    /// The stack.  It is reused by the successive parses.
     stack_type yystack_;
 
     /// Push a new state on the stack.
@@ -517,7 +593,9 @@ m4_if(b4_prefix, [yy], [],
     ]m4_ifset([b4_parse_param], [  ], [ :])[yydebug_ (false),
       yycdebug_ (&std::cerr)]m4_ifset([b4_parse_param], [,])[
 #endif]b4_parse_param_cons[
-  {}
+  {]b4_push_if([[
+    yynew_ = true;
+  ]])[}
 
   ]b4_parser_class_name::~b4_parser_class_name[ ()
   {}
@@ -576,7 +654,10 @@ m4_if(b4_prefix, [yy], [],
     that.type = empty;
   }
 
-  inline
+  inline]b4_move_if([[
+  ]b4_parser_class_name[::stack_symbol_type::stack_symbol_type (stack_symbol_type&& that)
+    : super_type (std::move (that))
+  {}]], [[
   ]b4_parser_class_name[::stack_symbol_type&
   ]b4_parser_class_name[::stack_symbol_type::operator= (const stack_symbol_type& that)
   {
@@ -586,7 +667,7 @@ m4_if(b4_prefix, [yy], [],
                    [[value = that.value;]])[]b4_locations_if([
     location = that.location;])[
     return *this;
-  }
+  }]])[
 
 
   template <typename Base>
@@ -691,19 +772,35 @@ m4_if(b4_prefix, [yy], [],
     return yyvalue == yytable_ninf_;
   }
 
+]b4_push_if([[  int
+  ]b4_parser_class_name[::push (symbol_type yysym)
+  {
+    return yyparse_ (&yysym);
+  }
+]b4_pull_if([[
   int
   ]b4_parser_class_name[::parse ()
+  {
+    return yyparse_ (YY_NULL);
+  }
+]])[
+  int
+  ]b4_parser_class_name[::yyparse_ (symbol_type* yypushed)]], [[  int
+  ]b4_parser_class_name[::parse ()]])[
   {
     /// Whether yyla contains a lookahead.
     bool yyempty = true;
 
     // State.
     int yyn;
-    int yylen = 0;
+    int yylen = 0;]b4_push_if([[
+
+    /// Whether the pushed token was read.
+    bool yypushed_read = false;]], [[
 
     // Error handling.
     int yynerrs_ = 0;
-    int yyerrstatus_ = 0;
+    int yyerrstatus_ = 0;]])[
 
     /// The lookahead symbol.
     symbol_type yyla;]b4_locations_if([[
@@ -720,7 +817,11 @@ m4_if(b4_prefix, [yy], [],
     // FIXME: This shoud be completely indented.  It is not yet to
     // avoid gratuitous conflicts when merging into the master branch.
     try
-      {
+      {]b4_push_if([[
+    // Resume the current parse, if any.
+    if (!yynew_]b4_pull_if([[ && yypushed]])[)
+      goto yybackup;
+]])[
     YYCDEBUG << "Starting parse" << std::endl;
 
 ]m4_ifdef([b4_initial_action], [
@@ -734,7 +835,10 @@ b4_dollar_popdef])[]dnl
        location values to have been already stored, initialize these
        stacks with a primary value.  */
     yystack_.clear ();
-    yypush_ (YY_NULL, 0, yyla);
+    yypush_ (YY_NULL, 0, yyla);]b4_push_if([[
+    yynerrs_ = 0;
+    yyerrstatus_ = 0;
+    yynew_ = false;]])[
 
     // A new symbol was pushed on the stack.
   yynewstate:
@@ -756,8 +860,20 @@ b4_dollar_popdef])[]dnl
 
     // Read a lookahead token.
     if (yyempty)
-      {
-        YYCDEBUG << "Reading a token: ";
+      {]b4_push_if([[
+        if (yypushed_read)
+          {
+            YYCDEBUG << "Return for a new token:" << std::endl;
+            yyresult = push_more;
+            goto yypushreturn;
+          }]])[
+        YYCDEBUG << "Reading a token: ";]b4_push_if([[
+        if (yypushed)
+          {
+            yyla.move (*yypushed);
+            yypushed_read = true;
+          }]b4_pull_if([[
+        else]])])[]b4_pull_if([[
         try
           {]b4_token_ctor_if([[
             symbol_type yylookahead (]b4_lex[);
@@ -768,7 +884,7 @@ b4_dollar_popdef])[]dnl
           {
             error (yyexc);
             goto yyerrlab1;
-          }
+          }]])[
         yyempty = false;
       }
     YY_SYMBOL_PRINT ("Next token is", yyla);
@@ -979,7 +1095,10 @@ b4_dollar_popdef])[]dnl
         yypop_ ();
       }
 
-    return yyresult;
+]b4_push_if([[    yynew_ = true;
+
+  yypushreturn:
+]])[    return yyresult;
   }
     catch (...)
       {
@@ -994,7 +1113,8 @@ b4_dollar_popdef])[]dnl
           {
             yy_destroy_ (YY_NULL, yystack_[0]);
             yypop_ ();
-          }
+          }]b4_push_if([[
+        yynew_ = true;]])[
         throw;
       }
   }
@@ -1019,7 +1139,9 @@ b4_error_verbose_if([state_type yystate, symbol_number_type yytoken],
     // Its maximum.
     enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
     // Arguments of yyformat.
-    char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
+    char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];]b4_error_tables_if([[
+    // Size of the reported token names.
+    size_t yysize = 0;]])[
 
     /* There are many possibilities here to consider:
        - If this state is a consistent state with a default action, then
@@ -1048,7 +1170,15 @@ b4_error_verbose_if([state_type yystate, symbol_number_type yytoken],
     */
     if (yytoken != yyempty_)
       {
-        yyarg[yycount++] = yytname_[yytoken];
+        yyarg[yycount++] = yytname_[yytoken];]b4_error_tables_if([[
+        yysize += yytname_size_[yytoken];
+        for (int yyi = yyexpected_base_[yystate],
+               yyn = yyexpected_count_[yystate]; 0 < yyn; --yyn)
+          {
+            int yyx = yyexpected_[yyi++];
+            yysize += yytname_size_[yyx];
+            yyarg[yycount++] = yytname_[yyx];
+          }]], [[
         int yyn = yypact_[yystate];
         if (!yy_pact_value_is_default_ (yyn))
           {
@@ -1071,7 +1201,7 @@ b4_error_verbose_if([state_type yystate, symbol_number_type yytoken],
                   else
                     yyarg[yycount++] = yytname_[yyx];
                 }
-          }
+          }]])[
       }
 
     char const* yyformat = YY_NULL;
@@ -1090,7 +1220,9 @@ b4_error_verbose_if([state_type yystate, symbol_number_type yytoken],
 #undef YYCASE_
       }
 
-    // Argument number.
+]b4_error_tables_if([[    yyres.reserve (yysize + std::char_traits<char>::length (yyformat));
+
+]])[    // Argument number.
     size_t yyi = 0;
     for (char const* yyp = yyformat; *yyp; ++yyp)
       if (yyp[0] == '%' && yyp[1] == 's' && yyi < yycount)
@@ -1110,7 +1242,15 @@ b4_error_verbose_if([state_type yystate, symbol_number_type yytoken],
   const ]b4_int_type(b4_table_ninf, b4_table_ninf) b4_parser_class_name::yytable_ninf_ = b4_table_ninf[;
 
 ]b4_parser_tables_define[
+]b4_error_tables_if([
+b4_integral_parser_table_define([expected_base], [b4_expected_base])
+
+b4_integral_parser_table_define([expected_count], [b4_expected_count])
 
+b4_integral_parser_table_define([expected], [b4_expected])
+
+b4_integral_parser_table_define([tname_size], [b4_tname_size])
+])[
 ]b4_token_table_if([], [[#if ]b4_api_PREFIX[DEBUG]])[
   // YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
   // First, the terminals, then, starting at \a yyntokens_, nonterminals.
@@ -37,6 +37,18 @@ dist_m4sugar_DATA =                             \
   data/m4sugar/foreach.m4                       \
   data/m4sugar/m4sugar.m4
 
+# The frozen state of m4sugar, reloaded by bison instead of parsing
+# m4sugar.m4 on every run.  It depends on the M4 in use, so it is
+# built, not distributed.
+nodist_m4sugar_DATA = data/m4sugar/m4sugar.m4f
+CLEANFILES += data/m4sugar/m4sugar.m4f
+data/m4sugar/m4sugar.m4f: $(dist_m4sugar_DATA)
+	$(AM_V_GEN)$(MKDIR_P) data/m4sugar
+	$(AM_V_at)rm -f $@ $@.tmp
+	$(AM_V_at)$(M4) $(M4_GNU) -I $(top_srcdir)/data -F $@.tmp \
+	  $(top_srcdir)/data/m4sugar/m4sugar.m4 </dev/null
+	$(AM_V_at)mv $@.tmp $@
+
 xsltdir = $(pkgdatadir)/xslt
 dist_xslt_DATA =                                \
   data/xslt/bison.xsl                           \
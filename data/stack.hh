@@ -21,7 +21,153 @@ m4_pushdef([b4_copyright_years],
 # b4_stack_define
 # ---------------
 m4_define([b4_stack_define],
-[[  template <class T, class S = std::vector<T> >
+[[  /// A sequence with room for \a N elements in place.  It allocates
+  /// memory only when it grows beyond, and keeps it until destroyed.
+  template <class T, unsigned int N>
+  class small_vector
+  {
+  public:
+    typedef unsigned int size_type;
+    typedef std::reverse_iterator<T*> reverse_iterator;
+    typedef std::reverse_iterator<const T*> const_reverse_iterator;
+
+    small_vector ()
+      : data_ (reinterpret_cast<T*> (buffer_.raw))
+      , size_ (0)
+      , capacity_ (N)
+    {
+    }
+
+    ~small_vector ()
+    {
+      clear ();
+      if (data_ != reinterpret_cast<T*> (buffer_.raw))
+        operator delete (data_);
+    }
+
+    inline
+    T&
+    operator[] (size_type i)
+    {
+      return data_[i];
+    }
+
+    inline
+    const T&
+    operator[] (size_type i) const
+    {
+      return data_[i];
+    }
+
+    inline
+    T&
+    back ()
+    {
+      return data_[size_ - 1];
+    }
+
+    /// Append a default-constructed element, built in place.
+    inline
+    T&
+    emplace_back ()
+    {
+      if (size_ == capacity_)
+        grow_ ();
+      T* res = new (data_ + size_) T ();
+      ++size_;
+      return *res;
+    }
+
+    inline
+    void
+    push_back (const T& t)
+    {
+      if (size_ == capacity_)
+        grow_ ();
+      new (data_ + size_) T (t);
+      ++size_;
+    }
+
+    inline
+    void
+    pop_back ()
+    {
+      data_[--size_].~T ();
+    }
+
+    void
+    clear ()
+    {
+      while (size_)
+        pop_back ();
+    }
+
+    inline
+    size_type
+    size () const
+    {
+      return size_;
+    }
+
+    inline
+    const_reverse_iterator
+    rbegin () const
+    {
+      return const_reverse_iterator (data_ + size_);
+    }
+
+    inline
+    const_reverse_iterator
+    rend () const
+    {
+      return const_reverse_iterator (data_);
+    }
+
+  private:
+    small_vector (const small_vector&);
+    small_vector& operator= (const small_vector&);
+
+    /// Double the capacity.  If constructing an element in the new
+    /// storage throws, the elements are left where they were.
+    void
+    grow_ ()
+    {
+      T* data = static_cast<T*> (operator new (2 * capacity_ * sizeof (T)));
+      size_type i = 0;
+      try
+        {
+          for (; i < size_; ++i)
+            new (data + i) T (]b4_move([data_@{i@}])[);
+        }
+      catch (...)
+        {
+          while (i)
+            data[--i].~T ();
+          operator delete (data);
+          throw;
+        }
+      for (i = 0; i < size_; ++i)
+        data_[i].~T ();
+      if (data_ != reinterpret_cast<T*> (buffer_.raw))
+        operator delete (data_);
+      data_ = data;
+      capacity_ *= 2;
+    }
+
+    /// The elements, in buffer_ or on the heap.
+    T* data_;
+    size_type size_;
+    size_type capacity_;
+    /// The storage of the first \a N elements.
+    union
+    {
+      /// Strongest alignment constraints.
+      long double align_me;
+      char raw[N * sizeof (T)];
+    } buffer_;
+  };
+
+  template <class T, class S = std::vector<T> >
   class stack
   {
   public:
@@ -60,8 +206,7 @@ m4_define([b4_stack_define],
     void
     push (T& t)
     {
-      seq_.push_back (T());
-      operator[](0).move (t);
+      emplace_ (seq_).move (t);
     }
 
     inline
@@ -102,6 +247,26 @@ m4_define([b4_stack_define],
   private:
     stack (const stack&);
     stack& operator= (const stack&);
+
+    /// Append a default-constructed element to \a s.
+    template <class C>
+    static
+    T&
+    emplace_ (C& s)
+    {
+      s.]b4_move_if([emplace_back ()], [push_back (T ())])[;
+      return s.back ();
+    }
+
+    /// Same as above, but build it in place.
+    template <unsigned int N>
+    static
+    T&
+    emplace_ (small_vector<T, N>& s)
+    {
+      return s.emplace_back ();
+    }
+
     /// The wrapped container.
     S seq_;
   };
@@ -141,6 +306,8 @@ b4_copyright([Stack handling for Bison parsers in C++])[
 
 ]b4_cpp_guard_open([b4_dir_prefix[]stack.hh])[
 
+# include <iterator>
+# include <new>
 # include <vector>
 
 ]b4_namespace_open[
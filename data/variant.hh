@@ -71,7 +71,8 @@ m4_map([      b4_symbol_tag_comment], [$@])dnl
 # -------------------
 # The needed includes for variants support.
 m4_define([b4_variant_includes],
-[b4_parse_assert_if([[#include <typeinfo>]])[
+[b4_parse_assert_if([[#include <typeinfo>]])[]b4_move_if([[
+#include <utility>]])[
 #ifndef YYASSERT
 # include <cassert>
 # define YYASSERT assert
@@ -134,6 +135,18 @@ m4_define([b4_variant_define],
       yytname_ = typeid (T).name ();])[
       return *new (yyas_<T> ()) T (t);
     }
+]b4_move_if([[
+    /// Instantiate a \a T in here, from the arguments \a u.
+    template <typename T, typename... U>
+    T&
+    emplace (U&&... u)
+    {]b4_parse_assert_if([
+      YYASSERT (!yytname_);
+      YYASSERT (sizeof (T) <= S);
+      yytname_ = typeid (T).name ();])[
+      return *new (yyas_<T> ()) T (std::forward<U> (u)...);
+    }
+]])[
 
     /// Accessor to a built \a T.
     template <typename T>
@@ -179,9 +192,10 @@ m4_define([b4_variant_define],
     void
     move (self_type& other)
     {]b4_parse_assert_if([
-      YYASSERT (!yytname_);])[
+      YYASSERT (!yytname_);])[]b4_move_if([[
+      emplace<T> (std::move (other.as<T> ()));]], [[
       build<T> ();
-      swap<T> (other);
+      swap<T> (other);]])[
       other.destroy<T> ();
     }
 
@@ -281,6 +295,16 @@ m4_define([b4_symbol_value_template],
 ## ------------- ##
 
 
+# b4_symbol_value_arg(SYMBOL-NUMBER)
+# ----------------------------------
+# The semantic value parameter of the constructors of SYMBOL-NUMBER:
+# passed by value to be moved from if the values are moved, by
+# reference otherwise.
+m4_define([b4_symbol_value_arg],
+[b4_move_if([b4_symbol([$1], [type])[ v]],
+            [const b4_symbol([$1], [type])[& v]])])
+
+
 # b4_symbol_constructor_declare_(SYMBOL-NUMBER)
 # ---------------------------------------------
 # Declare the overloaded version of make_symbol for the (common) type of
@@ -291,7 +315,7 @@ m4_define([b4_symbol_constructor_declare_],
     symbol_type
     make_[]b4_symbol_([$1], [id]) (dnl
 b4_join(b4_symbol_if([$1], [has_type],
-                     [const b4_symbol([$1], [type])& v]),
+                     [b4_symbol_value_arg([$1])]),
         b4_locations_if([const location_type& l])));
 
 ])])])
@@ -315,11 +339,11 @@ m4_define([b4_symbol_constructor_define_],
 [  b4_parser_class_name::symbol_type
   b4_parser_class_name::make_[]b4_symbol_([$1], [id]) (dnl
 b4_join(b4_symbol_if([$1], [has_type],
-                     [const b4_symbol([$1], [type])& v]),
+                     [b4_symbol_value_arg([$1])]),
         b4_locations_if([const location_type& l])))
   {
     return symbol_type (b4_join([token::b4_symbol([$1], [id])],
-                                b4_symbol_if([$1], [has_type], [v]),
+                                b4_symbol_if([$1], [has_type], [b4_move([v])]),
                                 b4_locations_if([l])));
 
   }
@@ -334,7 +358,7 @@ m4_define([b4_basic_symbol_constructor_declare],
 [[
   basic_symbol (]b4_join(
           [typename Base::kind_type t],
-          b4_symbol_if([$1], [has_type], const b4_symbol([$1], [type])[ v]),
+          b4_symbol_if([$1], [has_type], [b4_symbol_value_arg([$1])]),
           b4_locations_if([const location_type& l]))[);
 ]])
 
@@ -346,12 +370,14 @@ m4_define([b4_basic_symbol_constructor_define],
   template <typename Base>
   ]b4_parser_class_name[::basic_symbol<Base>::basic_symbol (]b4_join(
           [typename Base::kind_type t],
-          b4_symbol_if([$1], [has_type], const b4_symbol([$1], [type])[ v]),
+          b4_symbol_if([$1], [has_type], [b4_symbol_value_arg([$1])]),
           b4_locations_if([const location_type& l]))[)
     : Base (t)
-    , value (]b4_symbol_if([$1], [has_type], [v])[)]b4_locations_if([
+    , value (]b4_move_if([], [b4_symbol_if([$1], [has_type], [v])])[)]b4_locations_if([
     , location (l)])[
-  {}
+  {]b4_move_if([b4_symbol_if([$1], [has_type], [[
+    value.emplace< ]b4_symbol([$1], [type])[ > (std::move (v));
+  ]])])[}
 ]])
 
 # b4_symbol_constructor_define
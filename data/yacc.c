@@ -51,8 +51,26 @@ m4_define([b4_lac_flag],
           [m4_if(b4_percent_define_get([[parse.lac]]),
                  [none], [[0]], [[1]])])
 
+# Check the value of %define parse.codegen.
+b4_percent_define_default([[parse.codegen]], [[table]])
+b4_percent_define_check_values([[[[parse.codegen]], [[table]], [[direct]]]])
+b4_define_flag_if([direct])
+m4_define([b4_direct_flag],
+          [m4_if(b4_percent_define_get([[parse.codegen]]),
+                 [direct], [[1]], [[0]])])
+
 m4_include(b4_pkgdatadir/[c.m4])
 
+# Check the use of %define parse.error.tables.
+b4_error_tables_check
+
+# b4_expected_tables_if([IF-EXPECTED-TOKENS-ARE-PRECOMPUTED], [IF-NOT])
+# ---------------------------------------------------------------------
+# With LAC, the expected tokens depend on the whole stack, not only on
+# the current state: yysyntax_error computes them.
+m4_define([b4_expected_tables_if],
+[b4_error_tables_if([b4_lac_if([$2], [$1])], [$2])])
+
 ## ---------------- ##
 ## Default values.  ##
 ## ---------------- ##
@@ -162,6 +180,80 @@ m4_define([b4_rhs_location],
           [(yylsp@{b4_subtract([$2], [$1])@})])
 
 
+## ------------- ##
+## Direct code.  ##
+## ------------- ##
+
+# With %define parse.codegen direct, the main loop of yyparse looks up
+# the actions and the gotos in switches rather than in yypact,
+# yytable, yycheck and yypgoto.  The tables are still used for error
+# recovery and error messages.  Bison defines b4_direct_defaults,
+# b4_direct_actions, and b4_direct_gotos in terms of the macros below.
+
+# b4_direct_cases(NUMBER...)
+# --------------------------
+# The case labels for the NUMBERs.
+m4_define([b4_direct_cases],
+[m4_map_args_sep([case ], [:], [ ], $@)])
+
+
+# b4_direct_default(RULE, STATE...)
+# ---------------------------------
+# In the STATEs, reduce with RULE without a lookahead, or report an
+# error if RULE is 0.
+m4_define([b4_direct_default],
+[[    ]b4_direct_cases(m4_shift($@))[
+      ]m4_if([$1], [0], [[goto yyerrlab;]], [[yyn = $1;
+      goto yyreduce;]])])
+
+
+# b4_direct_state(STATE, ACTIONS)
+# -------------------------------
+# In STATE, set YYN to the yytable entry for YYTOKEN, as defined by the
+# b4_direct_action invocations of ACTIONS, or use the default action.
+m4_define([b4_direct_state],
+[[    case $1:
+      switch (yytoken)
+        {
+]$2[        default:
+          goto yynoaction;
+        }
+      break;]])
+
+
+# b4_direct_action(VALUE, TOKEN...)
+# ---------------------------------
+# The yytable entry for the TOKENs is VALUE.
+m4_define([b4_direct_action],
+[[        ]b4_direct_cases(m4_shift($@))[
+          yyn = $1;
+          break;]])
+
+
+# b4_direct_goto(NTERM, DEFAULT-STATE, GOTOS)
+# -------------------------------------------
+# After a reduction to NTERM, go to the state defined by the
+# b4_direct_goto_from invocations of GOTOS, or to DEFAULT-STATE.
+m4_define([b4_direct_goto],
+[[    case $1:
+      switch (*yyssp)
+        {
+]$3[        default:
+          yystate = $2;
+          break;
+        }
+      break;]])
+
+
+# b4_direct_goto_from(STATE, FROM-STATE...)
+# -----------------------------------------
+# After a reduction in the FROM-STATEs, go to STATE.
+m4_define([b4_direct_goto_from],
+[[        ]b4_direct_cases(m4_shift($@))[
+          yystate = $1;
+          break;]])
+
+
 ## -------------- ##
 ## Declarations.  ##
 ## -------------- ##
@@ -264,6 +356,8 @@ m4_define([b4_declare_yyparse_push_],
 enum { YYPUSH_MORE = 4 };
 #endif
 
+#include <stddef.h> /* size_t.  */
+
 typedef struct ]b4_prefix[pstate ]b4_prefix[pstate;
 
 ]b4_pull_if([b4_function_declare([b4_prefix[parse]], [[int]], b4_parse_param)
@@ -273,6 +367,14 @@ typedef struct ]b4_prefix[pstate ]b4_prefix[pstate;
   [[b4_api_PREFIX[STYPE const *pushed_val]], [[pushed_val]]]b4_locations_if([,
   [[b4_api_PREFIX[LTYPE *pushed_loc]], [[pushed_loc]]]])])m4_ifset([b4_parse_param], [,
   b4_parse_param]))
+b4_function_declare([b4_prefix[push_parse_batch]], [[int]],
+  [[b4_prefix[pstate *ps]], [[ps]]],
+  [[[int const *pushed_chars]], [[pushed_chars]]],
+  [[b4_api_PREFIX[STYPE const *pushed_vals]], [[pushed_vals]]]b4_locations_if([,
+  [[b4_api_PREFIX[LTYPE const *pushed_locs]], [[pushed_locs]]]]),
+  [[[size_t n]], [[n]]],
+  [[[size_t *consumed]], [[consumed]]]m4_ifset([b4_parse_param], [,
+  b4_parse_param]))
 b4_pull_if([b4_function_declare([b4_prefix[pull_parse]], [[int]],
   [[b4_prefix[pstate *ps]], [[ps]]]m4_ifset([b4_parse_param], [,
   b4_parse_param]))])
@@ -338,7 +440,8 @@ m4_if(b4_api_prefix, [yy], [],
 ]m4_if(b4_prefix, [yy], [],
 [[/* Substitute the variable and function names.  */]b4_pull_if([[
 #define yyparse         ]b4_prefix[parse]])b4_push_if([[
-#define yypush_parse    ]b4_prefix[push_parse]b4_pull_if([[
+#define yypush_parse    ]b4_prefix[push_parse
+#define yypush_parse_batch ]b4_prefix[push_parse_batch]b4_pull_if([[
 #define yypull_parse    ]b4_prefix[pull_parse]])[
 #define yypstate_new    ]b4_prefix[pstate_new
 #define yypstate_delete ]b4_prefix[pstate_delete
@@ -631,7 +734,23 @@ static const ]b4_int_type_for([b4_toknum])[ yytoknum[] =
   ]b4_table_value_equals([[table]], [[Yytable_value]], [b4_table_ninf])[
 
 ]b4_parser_tables_define[
-
+]b4_expected_tables_if([
+b4_integral_parser_table_define([expected_base], [b4_expected_base],
+  [[YYEXPECTED_BASE[STATE-NUM] -- Index in YYEXPECTED of the tokens
+reported as expected in the error messages in STATE-NUM.]])
+
+b4_integral_parser_table_define([expected_count], [b4_expected_count],
+  [[YYEXPECTED_COUNT[STATE-NUM] -- Number of these tokens, 0 if there
+are too many to be reported.]])
+
+b4_integral_parser_table_define([expected], [b4_expected],
+  [[YYEXPECTED -- The expected tokens of all the states, shared
+between them.]])
+])b4_error_tables_if([
+b4_integral_parser_table_define([tname_size], [b4_tname_size],
+  [[YYTNAME_SIZE[SYMBOL-NUM] -- Size of the name of the token
+SYMBOL-NUM in the error messages, as computed by yytnamerr.]])
+])[
 #define yyerrok         (yyerrstatus = 0)
 #define yyclearin       (yychar = YYEMPTY)
 #define YYEMPTY         (-2)
@@ -1062,7 +1181,13 @@ yy_lac (yytype_int16 *yyesa, yytype_int16 **yyes,
 #  endif
 # endif
 
-# ifndef yytnamerr
+]b4_error_tables_if([[# ifdef yytnamerr
+#  define YYTNAMERR_SIZE(Yyx) yytnamerr (YY_NULL, yytname[Yyx])
+# else
+#  define YYTNAMERR_SIZE(Yyx) ((YYSIZE_T) yytname_size[Yyx])
+# endif
+
+]])[# ifndef yytnamerr
 /* Copy to YYRES the contents of YYSTR after stripping away unnecessary
    quotes and backslashes, so that it's suitable for yyerror.  The
    heuristic is that double-quoting is unnecessary unless the string
@@ -1124,9 +1249,11 @@ static int
 yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
                 ]b4_lac_if([[yytype_int16 *yyesa, yytype_int16 **yyes,
                 YYSIZE_T *yyes_capacity, ]])[yytype_int16 *yyssp, int yytoken)
-{
-  YYSIZE_T yysize0 = yytnamerr (YY_NULL, yytname[yytoken]);
-  YYSIZE_T yysize = yysize0;
+{]b4_expected_tables_if([[
+  YYSIZE_T yysize = 0;]], [[
+  YYSIZE_T yysize0 = ]b4_error_tables_if([[YYTNAMERR_SIZE (yytoken)]],
+                                         [[yytnamerr (YY_NULL, yytname[yytoken])]])[;
+  YYSIZE_T yysize = yysize0;]])[
   enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
   /* Internationalized format string. */
   const char *yyformat = YY_NULL;
@@ -1165,7 +1292,21 @@ yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
        accepted due to an error action in a later state.]])[
   */
   if (yytoken != YYEMPTY)
-    {
+    {]b4_expected_tables_if([[
+      int yyi = yyexpected_base[*yyssp];
+      int yyn = yyexpected_count[*yyssp];
+      yysize = YYTNAMERR_SIZE (yytoken);
+      yyarg[yycount++] = yytname[yytoken];
+      for (; 0 < yyn; --yyn)
+        {
+          int yyx = yyexpected[yyi++];
+          YYSIZE_T yysize1 = yysize + YYTNAMERR_SIZE (yyx);
+          if (! (yysize <= yysize1
+                 && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
+            return 2;
+          yysize = yysize1;
+          yyarg[yycount++] = yytname[yyx];
+        }]], [[
       int yyn = yypact[*yyssp];]b4_lac_if([[
       YYDPRINTF ((stderr, "Constructing syntax error message\n"));]])[
       yyarg[yycount++] = yytname[yytoken];
@@ -1204,7 +1345,8 @@ yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
                   }
                 yyarg[yycount++] = yytname[yyx];
                 {
-                  YYSIZE_T yysize1 = yysize + yytnamerr (YY_NULL, yytname[yyx]);
+                  YYSIZE_T yysize1 = yysize + ]b4_error_tables_if([[YYTNAMERR_SIZE (yyx)]],
+                                                                  [[yytnamerr (YY_NULL, yytname[yyx])]])[;
                   if (! (yysize <= yysize1
                          && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
                     return 2;
@@ -1215,7 +1357,7 @@ yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
 # if ]b4_api_PREFIX[DEBUG
       else if (yydebug)
         YYFPRINTF (stderr, "No expected tokens.\n");
-# endif]])[
+# endif]])])[
     }
 
   switch (yycount)
@@ -1282,6 +1424,11 @@ struct yypstate
     /* Used to determine if this is the first time this instance has
        been used.  */
     int yynew;
+    /* The tokens of yypush_parse_batch not read yet.  */
+    int const *yybatch_chars;
+    YYSTYPE const *yybatch_vals;]b4_locations_if([[
+    YYLTYPE const *yybatch_locs;]])[
+    YYSIZE_T yybatch_n;
   };]b4_pure_if([], [[
 
 static char yypstate_allocated = 0;]])b4_pull_if([
@@ -1334,7 +1481,8 @@ b4_function_define([[yyparse]], [[int]], b4_parse_param)[
   yyps = (yypstate *) malloc (sizeof *yyps);
   if (!yyps)
     return YY_NULL;
-  yyps->yynew = 1;]b4_pure_if([], [[
+  yyps->yynew = 1;
+  yyps->yybatch_n = 0;]b4_pure_if([], [[
   yypstate_allocated = 1;]])[
   return yyps;
 }
@@ -1353,6 +1501,50 @@ b4_function_define([[yyparse]], [[int]], b4_parse_param)[
   free (yyps);]b4_pure_if([], [[
   yypstate_allocated = 0;]])[
 }
+
+/* Push the first N tokens of PUSHED_CHARS, with their semantic values
+   PUSHED_VALS]b4_locations_if([[ and their locations
+   PUSHED_LOCS]])[ (unless null), in a single call to yypush_parse.
+   Store in *CONSUMED the number of tokens read, which is less than N
+   if the parse ended before the last one.  */
+]b4_function_define([[yypush_parse_batch]], [[int]],
+  [[[yypstate *yyps]], [[yyps]]],
+  [[[int const *yypushed_chars]], [[yypushed_chars]]],
+  [[[YYSTYPE const *yypushed_vals]], [[yypushed_vals]]]b4_locations_if([,
+  [[[YYLTYPE const *yypushed_locs]], [[yypushed_locs]]]]),
+  [[[size_t yyn]], [[yyn]]],
+  [[[size_t *yyconsumed]], [[yyconsumed]]]m4_ifset([b4_parse_param], [,
+  b4_parse_param]))[
+{
+  int yystatus;]b4_pure_if([b4_locations_if([[
+  /* The first call to yypush_parse needs a location, and may run the
+     initial action on it.  */
+  static YYLTYPE yyloc_default][]b4_yyloc_default[;
+  YYLTYPE yyloc_first = yyloc_default;]])])[
+  if (!yyn)
+    {
+      *yyconsumed = 0;
+      return YYPUSH_MORE;
+    }
+  yyps->yybatch_chars = yypushed_chars + 1;
+  yyps->yybatch_vals = yypushed_vals ? yypushed_vals + 1 : YY_NULL;]b4_locations_if([[
+  yyps->yybatch_locs = yypushed_locs ? yypushed_locs + 1 : YY_NULL;]])[
+  yyps->yybatch_n = yyn - 1;]b4_pure_if([b4_locations_if([[
+  if (yypushed_locs)
+    yyloc_first = *yypushed_locs;]])[
+  yystatus = yypush_parse (yyps, *yypushed_chars, yypushed_vals]b4_locations_if([[,
+                           yypushed_locs || yyps->yynew
+                           ? &yyloc_first : YY_NULL]])[]b4_user_args[);]], [[
+  yychar = *yypushed_chars;
+  if (yypushed_vals)
+    yylval = *yypushed_vals;]b4_locations_if([[
+  if (yypushed_locs)
+    yylloc = *yypushed_locs;]])[
+  yystatus = yypush_parse (yyps]b4_user_args[);]])[
+  *yyconsumed = yyn - yyps->yybatch_n;
+  yyps->yybatch_n = 0;
+  return yystatus;
+}
 ]b4_pure_if([[
 #define ]b4_prefix[nerrs yyps->]b4_prefix[nerrs]])[
 #define yystate yyps->yystate
@@ -1547,16 +1739,33 @@ yybackup:
   /* Do appropriate processing given the current state.  Read a
      lookahead token if we need one and don't already have one.  */
 
-  /* First try to decide what to do without reference to lookahead token.  */
+  /* First try to decide what to do without reference to lookahead token.  */]b4_direct_if([[
+  switch (yystate)
+    {
+]b4_direct_defaults[    default:
+      break;
+    }]], [[
   yyn = yypact[yystate];
   if (yypact_value_is_default (yyn))
-    goto yydefault;
+    goto yydefault;]])[
 
   /* Not known => get a lookahead token if don't already have one.  */
 
   /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
   if (yychar == YYEMPTY)
     {]b4_push_if([[
+      if (!yyps->yynew && yyps->yybatch_n)
+        {
+          /* The next token of yypush_parse_batch.  */
+          YYDPRINTF ((stderr, "Reading a token: "));
+          --yyps->yybatch_n;
+          yychar = *yyps->yybatch_chars++;
+          if (yyps->yybatch_vals)
+            yylval = *yyps->yybatch_vals++;]b4_locations_if([[
+          if (yyps->yybatch_locs)
+            yylloc = *yyps->yybatch_locs++;]])[
+          goto yyread_batch_token;
+        }
       if (!yyps->yynew)
         {]b4_use_push_for_pull_if([], [[
           YYDPRINTF ((stderr, "Return for a new token:\n"));]])[
@@ -1578,7 +1787,8 @@ yyread_pushed_token:]])[
       if (yypushed_loc)
         yylloc = *yypushed_loc;]])])], [[
       yychar = ]b4_lex[;]])[
-    }
+    }]b4_push_if([[
+yyread_batch_token:]])[
 
   if (yychar <= YYEOF)
     {
@@ -1592,7 +1802,12 @@ yyread_pushed_token:]])[
     }
 
   /* If the proper action on seeing token YYTOKEN is to reduce or to
-     detect an error, take that action.  */
+     detect an error, take that action.  */]b4_direct_if([[
+  switch (yystate)
+    {
+]b4_direct_actions[    default:
+      goto yynoaction;
+    }]], [[
   yyn += yytoken;
   if (yyn < 0 || YYLAST < yyn || yycheck[yyn] != yytoken)]b4_lac_if([[
     {
@@ -1600,7 +1815,7 @@ yyread_pushed_token:]])[
       goto yydefault;
     }]], [[
     goto yydefault;]])[
-  yyn = yytable[yyn];
+  yyn = yytable[yyn];]])[
   if (yyn <= 0)
     {
       if (yytable_value_is_error (yyn))
@@ -1628,7 +1843,12 @@ yyread_pushed_token:]])[
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 ]b4_locations_if([  *++yylsp = yylloc;])[
   goto yynewstate;
-
+]b4_direct_if([[
+/* No entry for YYTOKEN in yytable.  */
+yynoaction:]b4_lac_if([[
+  YY_LAC_ESTABLISH;]])[
+  goto yydefault;
+]])[
 
 /*-----------------------------------------------------------.
 | yydefault -- do the default action for the current state.  |
@@ -1701,12 +1921,15 @@ yyreduce:
      number reduced by.  */
 
   yyn = yyr1[yyn];
-
+]b4_direct_if([[
+  switch (yyn)
+    {
+]b4_direct_gotos[    }]], [[
   yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
   if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
     yystate = yytable[yystate];
   else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+    yystate = yydefgoto[yyn - YYNTOKENS];]])[
 
   goto yynewstate;
 
@@ -0,0 +1,346 @@
+/* Bench the operations on array bitsets.
+
+   Copyright (C) 2013 Free Software Foundation, Inc.
+
+   This file is part of Bison, the GNU Compiler Compiler.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+/* Usage: bench-bitset [REPEAT [ROWS]]
+
+   For bitsets of 100, 500, 1000, 2000 and 5000 bits, the number of
+   tokens of small to huge grammars, run REPEAT times each of the
+   operations on which the analysis of the grammar relies (lalr.c,
+   closure.c, ielr.c, conflicts.c and tables.c) on ROWS fixed size
+   bitsets, with lib/abitset.c and with plain word loops, its former
+   implementation.  Check that the results are identical, and report
+   the CPU times.  */
+
+#include <config.h>
+
+#include <bitset.h>
+#include <bitsetv.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define WORDS(Bset) ((Bset)->b.cdata)
+#define NWORDS(Bset) ((Bset)->b.csize)
+
+/* The rows the operations apply to, and two result bitsets: for
+   lib/abitset.c, and for the word loops.  */
+static bitsetv rows;
+static int nrows;
+static bitset res;
+static bitset ref;
+
+/* A deterministic pseudo-random generator, so that runs compare.  */
+static unsigned long
+random_word (void)
+{
+  static unsigned long long x = 88172645463325252ULL;
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  return x;
+}
+
+/* Fill the rows of SIZE bits, with about one bit in eight set, as in
+   the lookahead sets.  */
+static void
+rows_fill (bitset_bindex size)
+{
+  int r;
+  bitset_bindex i;
+  for (r = 0; r < nrows; ++r)
+    {
+      bitset_zero (rows[r]);
+      for (i = 0; i < size; ++i)
+        if (random_word () % 8 == 0)
+          bitset_set (rows[r], i);
+    }
+}
+
+
+/*-------------------------------.
+| The operations, both ways.     |
+`-------------------------------*/
+
+/* Each operation returns something that depends on its results, so
+   that it cannot be optimized away.  */
+
+static unsigned long
+abitset_op_or (bitset a, bitset b)
+{
+  bitset_or (res, a, b);
+  return 0;
+}
+
+static unsigned long
+word_op_or (bitset a, bitset b)
+{
+  bitset_windex i;
+  for (i = 0; i < NWORDS (ref); ++i)
+    WORDS (ref)[i] = WORDS (a)[i] | WORDS (b)[i];
+  return 0;
+}
+
+/* As in lalr.c and ielr.c: accumulate into the result.  */
+static unsigned long
+abitset_op_or_cmp (bitset a, bitset b)
+{
+  (void) b;
+  return bitset_or_cmp (res, res, a);
+}
+
+static unsigned long
+word_op_or_cmp (bitset a, bitset b)
+{
+  bool changed = false;
+  bitset_windex i;
+  (void) b;
+  for (i = 0; i < NWORDS (ref); ++i)
+    {
+      bitset_word tmp = WORDS (ref)[i] | WORDS (a)[i];
+      if (WORDS (ref)[i] != tmp)
+        {
+          changed = true;
+          WORDS (ref)[i] = tmp;
+        }
+    }
+  return changed;
+}
+
+static unsigned long
+abitset_op_and (bitset a, bitset b)
+{
+  bitset_and (res, a, b);
+  return 0;
+}
+
+static unsigned long
+word_op_and (bitset a, bitset b)
+{
+  bitset_windex i;
+  for (i = 0; i < NWORDS (ref); ++i)
+    WORDS (ref)[i] = WORDS (a)[i] & WORDS (b)[i];
+  return 0;
+}
+
+static unsigned long
+abitset_op_andn (bitset a, bitset b)
+{
+  bitset_andn (res, a, b);
+  return 0;
+}
+
+static unsigned long
+word_op_andn (bitset a, bitset b)
+{
+  bitset_windex i;
+  for (i = 0; i < NWORDS (ref); ++i)
+    WORDS (ref)[i] = WORDS (a)[i] & ~WORDS (b)[i];
+  return 0;
+}
+
+static unsigned long
+abitset_op_copy (bitset a, bitset b)
+{
+  (void) b;
+  bitset_copy (res, a);
+  return 0;
+}
+
+static unsigned long
+word_op_copy (bitset a, bitset b)
+{
+  bitset_windex i;
+  (void) b;
+  for (i = 0; i < NWORDS (ref); ++i)
+    WORDS (ref)[i] = WORDS (a)[i];
+  return 0;
+}
+
+static unsigned long
+abitset_op_ones (bitset a, bitset b)
+{
+  (void) a;
+  (void) b;
+  bitset_ones (res);
+  return 0;
+}
+
+static unsigned long
+word_op_ones (bitset a, bitset b)
+{
+  bitset_windex i;
+  bitset_bindex last_bit = bitset_size (ref) % BITSET_WORD_BITS;
+  (void) a;
+  (void) b;
+  for (i = 0; i < NWORDS (ref); ++i)
+    WORDS (ref)[i] = -1;
+  if (last_bit)
+    WORDS (ref)[NWORDS (ref) - 1] &= ((bitset_word) 1 << last_bit) - 1;
+  return 0;
+}
+
+static unsigned long
+abitset_op_count (bitset a, bitset b)
+{
+  (void) b;
+  return bitset_count (a);
+}
+
+static unsigned long
+word_op_count (bitset a, bitset b)
+{
+  unsigned long sum = 0;
+  bitset_windex i;
+  (void) b;
+  for (i = 0; i < NWORDS (a); ++i)
+    {
+      bitset_word word;
+      for (word = WORDS (a)[i]; word; word >>= 1)
+        sum += word & 1;
+    }
+  return sum;
+}
+
+/* As in conflicts.c and tables.c: iterate over the bits.  */
+static unsigned long
+abitset_op_list (bitset a, bitset b)
+{
+  unsigned long sum = 0;
+  bitset_bindex i;
+  bitset_iterator iter;
+  (void) b;
+  BITSET_FOR_EACH (iter, a, i, 0)
+    sum += i;
+  return sum;
+}
+
+static unsigned long
+word_op_list (bitset a, bitset b)
+{
+  unsigned long sum = 0;
+  bitset_windex i;
+  (void) b;
+  for (i = 0; i < NWORDS (a); ++i)
+    {
+      bitset_bindex bitno = i * BITSET_WORD_BITS;
+      bitset_word word;
+      for (word = WORDS (a)[i]; word; word >>= 1, ++bitno)
+        if (word & 1)
+          sum += bitno;
+    }
+  return sum;
+}
+
+struct operation
+{
+  char const *name;
+  unsigned long (*abitset) (bitset a, bitset b);
+  unsigned long (*word) (bitset a, bitset b);
+};
+
+static struct operation const operations[] =
+  {
+    { "or",     abitset_op_or,     word_op_or },
+    { "or_cmp", abitset_op_or_cmp, word_op_or_cmp },
+    { "and",    abitset_op_and,    word_op_and },
+    { "andn",   abitset_op_andn,   word_op_andn },
+    { "copy",   abitset_op_copy,   word_op_copy },
+    { "ones",   abitset_op_ones,   word_op_ones },
+    { "count",  abitset_op_count,  word_op_count },
+    { "list",   abitset_op_list,   word_op_list },
+  };
+
+
+/*----------.
+| Benches.  |
+`----------*/
+
+static double
+seconds (clock_t start)
+{
+  return (double) (clock () - start) / CLOCKS_PER_SEC;
+}
+
+static bool
+bench (struct operation const *op, bitset_bindex size, int repeat)
+{
+  bool ok = true;
+  unsigned long sum = 0;
+  unsigned long ref_sum = 0;
+  clock_t start;
+  double abitset, words;
+  int i, r;
+
+  /* Check.  */
+  bitset_zero (res);
+  bitset_zero (ref);
+  for (r = 0; r < nrows; ++r)
+    {
+      bitset a = rows[r];
+      bitset b = rows[(r + 1) % nrows];
+      if (op->abitset (a, b) != op->word (a, b) || !bitset_equal_p (res, ref))
+        ok = false;
+    }
+  if (!ok)
+    fprintf (stderr, "%s: results differ for %lu bits\n",
+             op->name, (unsigned long) size);
+
+  start = clock ();
+  for (i = 0; i < repeat; ++i)
+    for (r = 0; r < nrows; ++r)
+      sum += op->abitset (rows[r], rows[(r + 1) % nrows]);
+  abitset = seconds (start);
+
+  start = clock ();
+  for (i = 0; i < repeat; ++i)
+    for (r = 0; r < nrows; ++r)
+      ref_sum += op->word (rows[r], rows[(r + 1) % nrows]);
+  words = seconds (start);
+
+  printf ("%-8s %5lu bits   abitset: %7.3fs   word loops: %7.3fs\n",
+          op->name, (unsigned long) size, abitset, words);
+  return ok && sum == ref_sum;
+}
+
+int
+main (int argc, char *argv[])
+{
+  static bitset_bindex const sizes[] = { 100, 500, 1000, 2000, 5000 };
+  int repeat = 1 < argc ? atoi (argv[1]) : 1000;
+  int status = EXIT_SUCCESS;
+  size_t s, o;
+
+  nrows = 2 < argc ? atoi (argv[2]) : 256;
+  for (s = 0; s < sizeof sizes / sizeof *sizes; ++s)
+    {
+      rows = bitsetv_create (nrows, sizes[s], BITSET_FIXED);
+      res = bitset_create (sizes[s], BITSET_FIXED);
+      ref = bitset_create (sizes[s], BITSET_FIXED);
+      rows_fill (sizes[s]);
+      for (o = 0; o < sizeof operations / sizeof *operations; ++o)
+        if (!bench (&operations[o], sizes[s], repeat))
+          status = EXIT_FAILURE;
+      bitsetv_free (rows);
+      bitset_free (res);
+      bitset_free (ref);
+    }
+  return status;
+}
@@ -0,0 +1,310 @@
+/* Bench the computation of the closures of the LR(0) states.
+
+   Copyright (C) 2013 Free Software Foundation, Inc.
+
+   This file is part of Bison, the GNU Compiler Compiler.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+/* Usage: bench-closure [SIZE [REPEAT]]
+
+   For each of the torture grammars of the test suite, with SIZE
+   tokens, compute REPEAT times the closures of all the LR(0) states
+   with closure.c, and with the former implementation, which merges
+   the rules of a bitset into the core, one at a time.  Check that the
+   results are identical, and report the CPU times.  */
+
+#include <config.h>
+#include "system.h"
+
+#include <bitset.h>
+#include <bitsetv.h>
+#include <time.h>
+
+#include "LR0.h"
+#include "closure.h"
+#include "compile.h"
+#include "complain.h"
+#include "derives.h"
+#include "files.h"
+#include "getargs.h"
+#include "gram.h"
+#include "muscle-tab.h"
+#include "nullable.h"
+#include "reader.h"
+#include "reduce.h"
+#include "state.h"
+#include "symtab.h"
+#include "uniqstr.h"
+
+/*-------------------------------------------------------------.
+| The torture grammars (see tests/torture.at), without their   |
+| actions, and a grammar with MAX levels of precedence written |
+| as rules.                                                    |
+`-------------------------------------------------------------*/
+
+/* Declare the tokens t1 ... tMAX.  */
+static void
+tokens_print (struct obstack *out, int max)
+{
+  int i;
+  obstack_sgrow (out, "%token");
+  for (i = 1; i <= max; ++i)
+    obstack_printf (out, "%s t%d", i % 16 ? "" : "\n ", i);
+  obstack_sgrow (out, "\n");
+}
+
+static void
+grammar_triangle (struct obstack *out, int max)
+{
+  int size, i;
+  tokens_print (out, max);
+  obstack_sgrow (out,
+                 "%token END\n%%\ninput: exp | input exp;\nexp: END\n");
+  for (size = 1; size <= max; ++size)
+    {
+      obstack_sgrow (out, "|");
+      for (i = 1; i <= size; ++i)
+        obstack_printf (out, " t%d", i);
+      obstack_sgrow (out, " END\n");
+    }
+  obstack_sgrow (out, ";\n");
+}
+
+static void
+grammar_horizontal (struct obstack *out, int max)
+{
+  int i;
+  tokens_print (out, max);
+  obstack_sgrow (out, "%%\nexp:");
+  for (i = 1; i <= max; ++i)
+    obstack_printf (out, " t%d", i);
+  obstack_sgrow (out, ";\n");
+}
+
+static void
+grammar_lookahead (struct obstack *out, int max)
+{
+  int i;
+  tokens_print (out, max);
+  obstack_sgrow (out,
+                 "%token token\n%%\ninput: exp | input exp;\n"
+                 "exp: n1 t1\n");
+  for (i = 2; i <= max; ++i)
+    obstack_printf (out, "| n%d t%d\n", i, i);
+  obstack_sgrow (out, ";\n");
+  for (i = 1; i <= max; ++i)
+    obstack_printf (out, "n%d: token;\n", i);
+}
+
+static void
+grammar_levels (struct obstack *out, int max)
+{
+  int i;
+  tokens_print (out, max);
+  obstack_sgrow (out, "%%\ne0: e1;\n");
+  for (i = 1; i < max; ++i)
+    obstack_printf (out, "e%d: e%d | e%d t%d e%d;\n", i, i + 1, i, i, i + 1);
+  obstack_printf (out, "e%d: 'n' | '(' e0 ')';\n", max);
+}
+
+struct grammar
+{
+  char const *name;
+  void (*print) (struct obstack *out, int max);
+};
+
+static struct grammar const grammars[] =
+  {
+    { "triangle",   grammar_triangle },
+    { "horizontal", grammar_horizontal },
+    { "lookahead",  grammar_lookahead },
+    { "levels",     grammar_levels },
+  };
+
+
+/*------------------------------------------------------------------.
+| The former closure: rule bitsets, merged into the core one rule   |
+| at a time.                                                        |
+`------------------------------------------------------------------*/
+
+static bitsetv ref_fderives;
+static bitset ref_ruleset;
+static item_number *ref_itemset;
+static size_t ref_nitemset;
+
+static void
+ref_new_closure (void)
+{
+  bitsetv firsts = bitsetv_create (nvars, nvars, BITSET_FIXED);
+  symbol_number i, j;
+  rule_number k;
+
+  for (i = ntokens; i < nsyms; i++)
+    for (k = 0; derives[i - ntokens][k]; ++k)
+      {
+        item_number sym = derives[i - ntokens][k]->rhs[0];
+        if (ISVAR (sym))
+          bitset_set (firsts[i - ntokens], sym - ntokens);
+      }
+  bitsetv_reflexive_transitive_closure (firsts);
+
+  ref_fderives = bitsetv_create (nvars, nrules, BITSET_FIXED);
+  for (i = ntokens; i < nsyms; ++i)
+    for (j = ntokens; j < nsyms; ++j)
+      if (bitset_test (firsts[i - ntokens], j - ntokens))
+        for (k = 0; derives[j - ntokens][k]; ++k)
+          bitset_set (ref_fderives[i - ntokens],
+                      derives[j - ntokens][k]->number);
+  bitsetv_free (firsts);
+
+  ref_ruleset = bitset_create (nrules, BITSET_FIXED);
+  ref_itemset = xnmalloc (nritems, sizeof *ref_itemset);
+}
+
+static void
+ref_closure (item_number const *core, size_t n)
+{
+  size_t c;
+  rule_number ruleno;
+  bitset_iterator iter;
+
+  bitset_zero (ref_ruleset);
+  for (c = 0; c < n; ++c)
+    if (ISVAR (ritem[core[c]]))
+      bitset_or (ref_ruleset, ref_ruleset,
+                 ref_fderives[ritem[core[c]] - ntokens]);
+
+  ref_nitemset = 0;
+  c = 0;
+  BITSET_FOR_EACH (iter, ref_ruleset, ruleno, 0)
+    {
+      item_number itemno = rules[ruleno].rhs - ritem;
+      while (c < n && core[c] < itemno)
+        ref_itemset[ref_nitemset++] = core[c++];
+      ref_itemset[ref_nitemset++] = itemno;
+    }
+  while (c < n)
+    ref_itemset[ref_nitemset++] = core[c++];
+}
+
+static void
+ref_free_closure (void)
+{
+  bitsetv_free (ref_fderives);
+  bitset_free (ref_ruleset);
+  free (ref_itemset);
+}
+
+
+/*----------.
+| Benches.  |
+`----------*/
+
+/* Read the grammar printed by G for MAX, and build its LR(0)
+   automaton.  */
+static bool
+automaton_build (struct grammar const *g, int max)
+{
+  struct obstack in;
+  obstack_init (&in);
+  g->print (&in, max);
+
+  muscle_init ();
+  complain_init ();
+  getargs_reset ();
+  current_file = grammar_file = uniqstr_new (g->name);
+  reader (obstack_base (&in), obstack_object_size (&in));
+  obstack_free (&in, NULL);
+  if (complaint_status)
+    return false;
+  reduce_grammar ();
+  derives_compute ();
+  nullable_compute ();
+  generate_states ();
+  return true;
+}
+
+static double
+seconds (clock_t start)
+{
+  return (double) (clock () - start) / CLOCKS_PER_SEC;
+}
+
+static bool
+bench (struct grammar const *g, int max, int repeat)
+{
+  bool res = true;
+  clock_t start;
+  double bitmaps, rules_merge;
+  state_number s;
+  int i;
+
+  if (!automaton_build (g, max))
+    {
+      compile_release ();
+      return false;
+    }
+
+  new_closure (nritems);
+  ref_new_closure ();
+  for (s = 0; s < nstates; ++s)
+    {
+      closure (states[s]->items, states[s]->nitems);
+      ref_closure (states[s]->items, states[s]->nitems);
+      if (nitemset != ref_nitemset
+          || memcmp (itemset, ref_itemset, nitemset * sizeof *itemset))
+        {
+          fprintf (stderr, "%s: closures differ in state %d\n", g->name, s);
+          res = false;
+        }
+    }
+
+  start = clock ();
+  for (i = 0; i < repeat; ++i)
+    for (s = 0; s < nstates; ++s)
+      closure (states[s]->items, states[s]->nitems);
+  bitmaps = seconds (start);
+
+  start = clock ();
+  for (i = 0; i < repeat; ++i)
+    for (s = 0; s < nstates; ++s)
+      ref_closure (states[s]->items, states[s]->nitems);
+  rules_merge = seconds (start);
+
+  printf ("%-10s %6d rules %6d states   item bitmaps: %7.3fs"
+          "   rule merge: %7.3fs\n",
+          g->name, nrules, nstates, bitmaps, rules_merge);
+
+  free_closure ();
+  ref_free_closure ();
+  compile_release ();
+  return res;
+}
+
+int
+main (int argc, char *argv[])
+{
+  int max = 1 < argc ? atoi (argv[1]) : 1000;
+  int repeat = 2 < argc ? atoi (argv[2]) : 10;
+  int exit_status = EXIT_SUCCESS;
+  size_t i;
+
+  uniqstrs_new ();
+  for (i = 0; i < sizeof grammars / sizeof *grammars; ++i)
+    if (!bench (&grammars[i], max, repeat))
+      exit_status = EXIT_FAILURE;
+  uniqstrs_free ();
+  return exit_status;
+}
@@ -14,3 +14,8 @@
 ## along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 nodist_noinst_SCRIPTS = etc/bench.pl
+
+# Built on demand: make etc/bench-bitset etc/bench-closure.
+EXTRA_PROGRAMS = etc/bench-bitset etc/bench-closure
+etc_bench_closure_LDADD = src/libbison-api.a $(LDADD)
+etc_bench_closure_CPPFLAGS = $(AM_CPPFLAGS) -Isrc -I$(top_srcdir)/src
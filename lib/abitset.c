@@ -21,6 +21,8 @@
 #include <config.h>
 
 #include "abitset.h"
+#include <count-one-bits.h>
+#include <count-trailing-zeros.h>
 #include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
@@ -31,6 +33,21 @@
 #define ABITSET_N_WORDS(N) (((N) + BITSET_WORD_BITS - 1) / BITSET_WORD_BITS)
 #define ABITSET_WORDS(X) ((X)->a.words)
 
+/* The loops on the words of multiple word bitsets are written without
+   branches, so that the compiler vectorizes them.  On x86-64 GNU
+   systems, GCC also compiles them for AVX2 (and the count for
+   POPCNT), and the dynamic linker selects the version to use when the
+   program starts, from the features of the CPU; the default version
+   remains for the other CPUs.  */
+#if (7 <= __GNUC__ && !defined __clang__ && defined __x86_64__ \
+     && defined __ELF__ && defined __GLIBC__)
+# define ABITSET_TARGETS(Targets) __attribute__ ((__target_clones__ (Targets)))
+#else
+# define ABITSET_TARGETS(Targets)
+#endif
+#define ABITSET_VECTOR ABITSET_TARGETS ("avx2,default")
+#define ABITSET_POPCOUNT ABITSET_TARGETS ("popcnt,default")
+
 
 static bitset_bindex
 abitset_resize (bitset src, bitset_bindex size)
@@ -221,9 +238,6 @@ abitset_list (bitset src, bitset_bindex *list,
       if (windex >= size)
         return 0;
 
-      /* If num is 1, we could speed things up with a binary search
-         of the current word.  */
-
       bitoff = windex * BITSET_WORD_BITS;
     }
   else
@@ -242,55 +256,40 @@ abitset_list (bitset src, bitset_bindex *list,
              on the previous call to this function.  */
 
           bitoff = windex * BITSET_WORD_BITS;
-          word = srcp[windex] >> bitno;
-          for (bitno = bitoff + bitno; word; bitno++)
+          word = srcp[windex] >> bitno << bitno;
+          for (; word; word &= word - 1)
             {
-              if (word & 1)
+              list[count++] = bitoff + count_trailing_zeros_l (word);
+              if (count >= num)
                 {
-                  list[count++] = bitno;
-                  if (count >= num)
-                    {
-                      *next = bitno + 1;
-                      return count;
-                    }
+                  *next = list[count - 1] + 1;
+                  return count;
                 }
-              word >>= 1;
             }
           windex++;
         }
       bitoff = windex * BITSET_WORD_BITS;
     }
 
+  /* Jump from one set bit to the next, clearing them one at a time.  */
   for (; windex < size; windex++, bitoff += BITSET_WORD_BITS)
     {
       if (!(word = srcp[windex]))
         continue;
 
       if ((count + BITSET_WORD_BITS) < num)
-        {
-          for (bitno = bitoff; word; bitno++)
-            {
-              if (word & 1)
-                list[count++] = bitno;
-              word >>= 1;
-            }
-        }
+        for (; word; word &= word - 1)
+          list[count++] = bitoff + count_trailing_zeros_l (word);
       else
-        {
-          for (bitno = bitoff; word; bitno++)
-            {
-              if (word & 1)
-                {
-                  list[count++] = bitno;
-                  if (count >= num)
-                    {
-                      *next = bitno + 1;
-                      return count;
-                    }
-                }
-              word >>= 1;
-            }
-        }
+        for (; word; word &= word - 1)
+          {
+            list[count++] = bitoff + count_trailing_zeros_l (word);
+            if (count >= num)
+              {
+                *next = list[count - 1] + 1;
+                return count;
+              }
+          }
     }
 
   *next = bitoff;
@@ -350,6 +349,20 @@ abitset_empty_p (bitset dst)
 }
 
 
+static bitset_bindex ABITSET_POPCOUNT
+abitset_count (bitset src)
+{
+  bitset_windex i;
+  bitset_bindex count = 0;
+  bitset_word *srcp = ABITSET_WORDS (src);
+  bitset_windex size = src->b.csize;
+
+  for (i = 0; i < size; i++)
+    count += count_one_bits_l (srcp[i]);
+  return count;
+}
+
+
 static void
 abitset_copy1 (bitset dst, bitset src)
 {
@@ -363,7 +376,7 @@ abitset_copy1 (bitset dst, bitset src)
 }
 
 
-static void
+static void ABITSET_VECTOR
 abitset_not (bitset dst, bitset src)
 {
   bitset_windex i;
@@ -372,7 +385,7 @@ abitset_not (bitset dst, bitset src)
   bitset_windex size = dst->b.csize;
 
   for (i = 0; i < size; i++)
-      *dstp++ = ~(*srcp++);
+    dstp[i] = ~srcp[i];
   abitset_unused_clear (dst);
 }
 
@@ -423,7 +436,7 @@ abitset_disjoint_p (bitset dst, bitset src)
 }
 
 
-static void
+static void ABITSET_VECTOR
 abitset_and (bitset dst, bitset src1, bitset src2)
 {
   bitset_windex i;
@@ -433,35 +446,31 @@ abitset_and (bitset dst, bitset src1, bitset src2)
   bitset_windex size = dst->b.csize;
 
   for (i = 0; i < size; i++)
-      *dstp++ = *src1p++ & *src2p++;
+    dstp[i] = src1p[i] & src2p[i];
 }
 
 
-static bool
+static bool ABITSET_VECTOR
 abitset_and_cmp (bitset dst, bitset src1, bitset src2)
 {
   bitset_windex i;
-  bool changed = false;
+  bitset_word changed = 0;
   bitset_word *src1p = ABITSET_WORDS (src1);
   bitset_word *src2p = ABITSET_WORDS (src2);
   bitset_word *dstp = ABITSET_WORDS (dst);
   bitset_windex size = dst->b.csize;
 
-  for (i = 0; i < size; i++, dstp++)
+  for (i = 0; i < size; i++)
     {
-      bitset_word tmp = *src1p++ & *src2p++;
-
-      if (*dstp != tmp)
-        {
-          changed = true;
-          *dstp = tmp;
-        }
+      bitset_word tmp = src1p[i] & src2p[i];
+      changed |= dstp[i] ^ tmp;
+      dstp[i] = tmp;
     }
-  return changed;
+  return changed != 0;
 }
 
 
-static void
+static void ABITSET_VECTOR
 abitset_andn (bitset dst, bitset src1, bitset src2)
 {
   bitset_windex i;
@@ -471,35 +480,31 @@ abitset_andn (bitset dst, bitset src1, bitset src2)
   bitset_windex size = dst->b.csize;
 
   for (i = 0; i < size; i++)
-      *dstp++ = *src1p++ & ~(*src2p++);
+    dstp[i] = src1p[i] & ~src2p[i];
 }
 
 
-static bool
+static bool ABITSET_VECTOR
 abitset_andn_cmp (bitset dst, bitset src1, bitset src2)
 {
   bitset_windex i;
-  bool changed = false;
+  bitset_word changed = 0;
   bitset_word *src1p = ABITSET_WORDS (src1);
   bitset_word *src2p = ABITSET_WORDS (src2);
   bitset_word *dstp = ABITSET_WORDS (dst);
   bitset_windex size = dst->b.csize;
 
-  for (i = 0; i < size; i++, dstp++)
+  for (i = 0; i < size; i++)
     {
-      bitset_word tmp = *src1p++ & ~(*src2p++);
-
-      if (*dstp != tmp)
-        {
-          changed = true;
-          *dstp = tmp;
-        }
+      bitset_word tmp = src1p[i] & ~src2p[i];
+      changed |= dstp[i] ^ tmp;
+      dstp[i] = tmp;
     }
-  return changed;
+  return changed != 0;
 }
 
 
-static void
+static void ABITSET_VECTOR
 abitset_or (bitset dst, bitset src1, bitset src2)
 {
   bitset_windex i;
@@ -509,35 +514,31 @@ abitset_or (bitset dst, bitset src1, bitset src2)
   bitset_windex size = dst->b.csize;
 
   for (i = 0; i < size; i++)
-      *dstp++ = *src1p++ | *src2p++;
+    dstp[i] = src1p[i] | src2p[i];
 }
 
 
-static bool
+static bool ABITSET_VECTOR
 abitset_or_cmp (bitset dst, bitset src1, bitset src2)
 {
   bitset_windex i;
-  bool changed = false;
+  bitset_word changed = 0;
   bitset_word *src1p = ABITSET_WORDS (src1);
   bitset_word *src2p = ABITSET_WORDS (src2);
   bitset_word *dstp = ABITSET_WORDS (dst);
   bitset_windex size = dst->b.csize;
 
-  for (i = 0; i < size; i++, dstp++)
+  for (i = 0; i < size; i++)
     {
-      bitset_word tmp = *src1p++ | *src2p++;
-
-      if (*dstp != tmp)
-        {
-          changed = true;
-          *dstp = tmp;
-        }
+      bitset_word tmp = src1p[i] | src2p[i];
+      changed |= dstp[i] ^ tmp;
+      dstp[i] = tmp;
     }
-  return changed;
+  return changed != 0;
 }
 
 
-static void
+static void ABITSET_VECTOR
 abitset_xor (bitset dst, bitset src1, bitset src2)
 {
   bitset_windex i;
@@ -547,35 +548,31 @@ abitset_xor (bitset dst, bitset src1, bitset src2)
   bitset_windex size = dst->b.csize;
 
   for (i = 0; i < size; i++)
-      *dstp++ = *src1p++ ^ *src2p++;
+    dstp[i] = src1p[i] ^ src2p[i];
 }
 
 
-static bool
+static bool ABITSET_VECTOR
 abitset_xor_cmp (bitset dst, bitset src1, bitset src2)
 {
   bitset_windex i;
-  bool changed = false;
+  bitset_word changed = 0;
   bitset_word *src1p = ABITSET_WORDS (src1);
   bitset_word *src2p = ABITSET_WORDS (src2);
   bitset_word *dstp = ABITSET_WORDS (dst);
   bitset_windex size = dst->b.csize;
 
-  for (i = 0; i < size; i++, dstp++)
+  for (i = 0; i < size; i++)
     {
-      bitset_word tmp = *src1p++ ^ *src2p++;
-
-      if (*dstp != tmp)
-        {
-          changed = true;
-          *dstp = tmp;
-        }
+      bitset_word tmp = src1p[i] ^ src2p[i];
+      changed |= dstp[i] ^ tmp;
+      dstp[i] = tmp;
     }
-  return changed;
+  return changed != 0;
 }
 
 
-static void
+static void ABITSET_VECTOR
 abitset_and_or (bitset dst, bitset src1, bitset src2, bitset src3)
 {
   bitset_windex i;
@@ -586,36 +583,32 @@ abitset_and_or (bitset dst, bitset src1, bitset src2, bitset src3)
   bitset_windex size = dst->b.csize;
 
   for (i = 0; i < size; i++)
-      *dstp++ = (*src1p++ & *src2p++) | *src3p++;
+    dstp[i] = (src1p[i] & src2p[i]) | src3p[i];
 }
 
 
-static bool
+static bool ABITSET_VECTOR
 abitset_and_or_cmp (bitset dst, bitset src1, bitset src2, bitset src3)
 {
   bitset_windex i;
-  bool changed = false;
+  bitset_word changed = 0;
   bitset_word *src1p = ABITSET_WORDS (src1);
   bitset_word *src2p = ABITSET_WORDS (src2);
   bitset_word *src3p = ABITSET_WORDS (src3);
   bitset_word *dstp = ABITSET_WORDS (dst);
   bitset_windex size = dst->b.csize;
 
-  for (i = 0; i < size; i++, dstp++)
+  for (i = 0; i < size; i++)
     {
-      bitset_word tmp = (*src1p++ & *src2p++) | *src3p++;
-
-      if (*dstp != tmp)
-        {
-          changed = true;
-          *dstp = tmp;
-        }
+      bitset_word tmp = (src1p[i] & src2p[i]) | src3p[i];
+      changed |= dstp[i] ^ tmp;
+      dstp[i] = tmp;
     }
-  return changed;
+  return changed != 0;
 }
 
 
-static void
+static void ABITSET_VECTOR
 abitset_andn_or (bitset dst, bitset src1, bitset src2, bitset src3)
 {
   bitset_windex i;
@@ -626,36 +619,32 @@ abitset_andn_or (bitset dst, bitset src1, bitset src2, bitset src3)
   bitset_windex size = dst->b.csize;
 
   for (i = 0; i < size; i++)
-      *dstp++ = (*src1p++ & ~(*src2p++)) | *src3p++;
+    dstp[i] = (src1p[i] & ~src2p[i]) | src3p[i];
 }
 
 
-static bool
+static bool ABITSET_VECTOR
 abitset_andn_or_cmp (bitset dst, bitset src1, bitset src2, bitset src3)
 {
   bitset_windex i;
-  bool changed = false;
+  bitset_word changed = 0;
   bitset_word *src1p = ABITSET_WORDS (src1);
   bitset_word *src2p = ABITSET_WORDS (src2);
   bitset_word *src3p = ABITSET_WORDS (src3);
   bitset_word *dstp = ABITSET_WORDS (dst);
   bitset_windex size = dst->b.csize;
 
-  for (i = 0; i < size; i++, dstp++)
+  for (i = 0; i < size; i++)
     {
-      bitset_word tmp = (*src1p++ & ~(*src2p++)) | *src3p++;
-
-      if (*dstp != tmp)
-        {
-          changed = true;
-          *dstp = tmp;
-        }
+      bitset_word tmp = (src1p[i] & ~src2p[i]) | src3p[i];
+      changed |= dstp[i] ^ tmp;
+      dstp[i] = tmp;
     }
-  return changed;
+  return changed != 0;
 }
 
 
-static void
+static void ABITSET_VECTOR
 abitset_or_and (bitset dst, bitset src1, bitset src2, bitset src3)
 {
   bitset_windex i;
@@ -666,32 +655,28 @@ abitset_or_and (bitset dst, bitset src1, bitset src2, bitset src3)
   bitset_windex size = dst->b.csize;
 
   for (i = 0; i < size; i++)
-      *dstp++ = (*src1p++ | *src2p++) & *src3p++;
+    dstp[i] = (src1p[i] | src2p[i]) & src3p[i];
 }
 
 
-static bool
+static bool ABITSET_VECTOR
 abitset_or_and_cmp (bitset dst, bitset src1, bitset src2, bitset src3)
 {
   bitset_windex i;
-  bool changed = false;
+  bitset_word changed = 0;
   bitset_word *src1p = ABITSET_WORDS (src1);
   bitset_word *src2p = ABITSET_WORDS (src2);
   bitset_word *src3p = ABITSET_WORDS (src3);
   bitset_word *dstp = ABITSET_WORDS (dst);
   bitset_windex size = dst->b.csize;
 
-  for (i = 0; i < size; i++, dstp++)
+  for (i = 0; i < size; i++)
     {
-      bitset_word tmp = (*src1p++ | *src2p++) & *src3p++;
-
-      if (*dstp != tmp)
-        {
-          changed = true;
-          *dstp = tmp;
-        }
+      bitset_word tmp = (src1p[i] | src2p[i]) & src3p[i];
+      changed |= dstp[i] ^ tmp;
+      dstp[i] = tmp;
     }
-  return changed;
+  return changed != 0;
 }
 
 
@@ -713,7 +698,7 @@ struct bitset_vtable abitset_small_vtable = {
   abitset_test,
   abitset_resize,
   bitset_size_,
-  bitset_count_,
+  abitset_count,
   abitset_empty_p,
   abitset_ones,
   abitset_zero,
@@ -751,7 +736,7 @@ struct bitset_vtable abitset_vtable = {
   abitset_test,
   abitset_resize,
   bitset_size_,
-  bitset_count_,
+  abitset_count,
   abitset_empty_p,
   abitset_ones,
   abitset_zero,
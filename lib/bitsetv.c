@@ -22,6 +22,13 @@
 
 #include <stdlib.h>
 
+#include "abitset.h"
+#include "ebitset.h"
+#include "lbitset.h"
+
+/* The number of rows bitsetv_adapt samples.  */
+#define BITSETV_ADAPT_SAMPLES 64
+
 
 /* Create a vector of N_VECS bitsets, each of N_BITS, and of
    type TYPE.  */
@@ -71,6 +78,54 @@ bitsetv_create (bitset_bindex n_vecs, bitset_bindex n_bits, unsigned int attr)
 }
 
 
+/* Return a vector with the contents of the fixed size vector BSETV
+   in the type of bitsets that uses the least memory for them, and
+   free BSETV; or return BSETV if it is its best type.  The density
+   is estimated on a sample of the rows.  Sparse bitsets save memory,
+   but their operations are slower, so they are chosen only when they
+   save at least a quarter of the memory.  */
+bitsetv
+bitsetv_adapt (bitsetv bsetv)
+{
+  bitset_bindex n_vecs;
+  bitset_bindex n_bits;
+  bitset_bindex step;
+  bitset_bindex i;
+  size_t array_bytes = 0;
+  size_t list_bytes = 0;
+  size_t table_bytes = 0;
+  enum bitset_type type = BITSET_ARRAY;
+  bitsetv res;
+
+  if (!bsetv[0] || bitset_type_get (bsetv[0]) != BITSET_ARRAY)
+    return bsetv;
+
+  for (n_vecs = 0; bsetv[n_vecs]; n_vecs++)
+    continue;
+  n_bits = bitset_size (bsetv[0]);
+  step = n_vecs / BITSETV_ADAPT_SAMPLES + 1;
+  for (i = 0; i < n_vecs; i += step)
+    {
+      array_bytes += abitset_bytes (n_bits);
+      list_bytes += lbitset_footprint (bsetv[i]);
+      table_bytes += ebitset_footprint (bsetv[i]);
+    }
+
+  if (table_bytes <= list_bytes && table_bytes <= array_bytes / 4 * 3)
+    type = BITSET_TABLE;
+  else if (list_bytes < table_bytes && list_bytes <= array_bytes / 4 * 3)
+    type = BITSET_LIST;
+  else
+    return bsetv;
+
+  res = bitsetv_alloc (n_vecs, n_bits, type);
+  for (i = 0; i < n_vecs; i++)
+    bitset_copy (res[i], bsetv[i]);
+  bitsetv_free (bsetv);
+  return res;
+}
+
+
 /* Free bitset vector BSETV.  */
 void
 bitsetv_free (bitsetv bsetv)
@@ -32,6 +32,13 @@ extern bitsetv bitsetv_alloc (bitset_bindex, bitset_bindex, enum bitset_type);
    attribute hints specified by ATTR.  */
 extern bitsetv bitsetv_create (bitset_bindex, bitset_bindex, unsigned int);
 
+/* Return a vector with the contents of a fixed size vector, in the
+   type of bitsets that uses the least memory, and free the latter.
+   The result may differ from the BITSET_FIXED bitsets in type: the
+   operations of two bitsets of different types, except copy, are
+   not supported.  */
+extern bitsetv bitsetv_adapt (bitsetv);
+
 /* Free vector of bitsets.  */
 extern void bitsetv_free (bitsetv);
 
@@ -1330,6 +1330,28 @@ ebitset_bytes (bitset_bindex n_bits ATTRIBUTE_UNUSED)
 }
 
 
+/* Return the number of bytes a table bitset with the contents of
+   SRC, a bitset of any type, would use.  */
+size_t
+ebitset_footprint (bitset src)
+{
+  bitset_bindex n_elts = 0;
+  bitset_bindex last = BITSET_BINDEX_MAX;
+  bitset_bindex i;
+  bitset_iterator iter;
+
+  BITSET_FOR_EACH (iter, src, i, 0)
+    if (i / EBITSET_ELT_BITS != last)
+      {
+        last = i / EBITSET_ELT_BITS;
+        n_elts++;
+      }
+  return (sizeof (struct ebitset_struct)
+          + EBITSET_N_ELTS (bitset_size (src)) * sizeof (ebitset_elt *)
+          + n_elts * sizeof (ebitset_elt));
+}
+
+
 /* Initialize a bitset.  */
 
 bitset
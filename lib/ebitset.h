@@ -24,6 +24,8 @@
 
 extern size_t ebitset_bytes (bitset_bindex);
 
+extern size_t ebitset_footprint (bitset);
+
 extern bitset ebitset_init (bitset, bitset_bindex);
 
 extern void ebitset_release_memory (void);
@@ -443,7 +443,7 @@ lbitset_equal_p (bitset dst, bitset src)
 
 /* Copy bits from bitset SRC to bitset DST.  */
 static inline void
-lbitset_copy (bitset dst, bitset src)
+lbitset_copy_ (bitset dst, bitset src)
 {
   lbitset_elt *elt;
   lbitset_elt *head;
@@ -492,14 +492,14 @@ lbitset_copy_cmp (bitset dst, bitset src)
 
   if (!LBITSET_HEAD (dst))
     {
-      lbitset_copy (dst, src);
+      lbitset_copy_ (dst, src);
       return LBITSET_HEAD (src) != 0;
     }
 
   if (lbitset_equal_p (dst, src))
     return false;
 
-  lbitset_copy (dst, src);
+  lbitset_copy_ (dst, src);
   return true;
 }
 
@@ -1302,6 +1302,16 @@ lbitset_xor (bitset dst, bitset src1, bitset src2)
 }
 
 
+static void
+lbitset_copy (bitset dst, bitset src)
+{
+  if (BITSET_COMPATIBLE_ (dst, src))
+    lbitset_copy_ (dst, src);
+  else
+    bitset_copy_ (dst, src);
+}
+
+
 
 /* Vector of operations for linked-list bitsets.  */
 struct bitset_vtable lbitset_vtable = {
@@ -1349,6 +1359,26 @@ lbitset_bytes (bitset_bindex n_bits ATTRIBUTE_UNUSED)
 }
 
 
+/* Return the number of bytes a list bitset with the contents of SRC,
+   a bitset of any type, would use.  */
+size_t
+lbitset_footprint (bitset src)
+{
+  bitset_bindex n_elts = 0;
+  bitset_bindex last = BITSET_BINDEX_MAX;
+  bitset_bindex i;
+  bitset_iterator iter;
+
+  BITSET_FOR_EACH (iter, src, i, 0)
+    if (i / LBITSET_ELT_BITS != last)
+      {
+        last = i / LBITSET_ELT_BITS;
+        n_elts++;
+      }
+  return sizeof (struct lbitset_struct) + n_elts * sizeof (lbitset_elt);
+}
+
+
 /* Initialize a bitset.  */
 bitset
 lbitset_init (bitset bset, bitset_bindex n_bits ATTRIBUTE_UNUSED)
@@ -24,6 +24,8 @@
 
 extern size_t lbitset_bytes (bitset_bindex);
 
+extern size_t lbitset_footprint (bitset);
+
 extern bitset lbitset_init (bitset, bitset_bindex);
 
 extern void lbitset_release_memory (void);
@@ -51,13 +51,15 @@ static state_list *last_state = NULL;
 /*------------------------------------------------------------------.
 | A state was just discovered from another state.  Queue it for     |
 | later examination, in order to find its transitions.  Return it.  |
+| FP is the fingerprint of CORE.                                    |
 `------------------------------------------------------------------*/
 
 static state *
-state_list_append (symbol_number sym, size_t core_size, item_number *core)
+state_list_append (symbol_number sym, size_t core_size, item_number *core,
+                   core_fingerprint fp)
 {
   state_list *node = xmalloc (sizeof *node);
-  state *s = state_new (sym, core_size, core);
+  state *s = state_new (sym, core_size, core, fp);
 
   if (trace_flag & trace_automaton)
     fprintf (stderr, "state_list_append (state = %d, symbol = %d (%s))\n",
@@ -83,6 +85,7 @@ static state **shiftset;
 
 static item_number **kernel_base;
 static int *kernel_size;
+static core_fingerprint *kernel_fingerprint;
 static item_number *kernel_items;
 
 
@@ -126,6 +129,7 @@ allocate_itemsets (void)
 
   free (symbol_count);
   kernel_size = xnmalloc (nsyms, sizeof *kernel_size);
+  kernel_fingerprint = xnmalloc (nsyms, sizeof *kernel_fingerprint);
 }
 
 
@@ -149,6 +153,7 @@ free_storage (void)
   free (shiftset);
   free (kernel_base);
   free (kernel_size);
+  free (kernel_fingerprint);
   free (kernel_items);
   state_hash_free ();
 }
@@ -165,6 +170,7 @@ free_storage (void)
 | shifted.  For each symbol in the grammar, kernel_base[symbol]  |
 | points to a vector of item numbers activated if that symbol is |
 | shifted, and kernel_size[symbol] is their numbers.             |
+| kernel_fingerprint[symbol] is the fingerprint of this core.    |
 |                                                                |
 | itemset is sorted on item index in ritem, which is sorted on   |
 | rule number.  Compute each kernel_base[symbol] with the same   |
@@ -191,10 +197,13 @@ new_itemsets (state *s)
           {
             shift_symbol[nshifts] = sym;
             nshifts++;
+            kernel_fingerprint[sym] = CORE_FINGERPRINT_EMPTY;
           }
 
         kernel_base[sym][kernel_size[sym]] = itemset[i] + 1;
         kernel_size[sym]++;
+        kernel_fingerprint[sym] =
+          core_fingerprint_add (kernel_fingerprint[sym], itemset[i] + 1);
       }
 }
 
@@ -202,12 +211,14 @@ new_itemsets (state *s)
 
 /*--------------------------------------------------------------.
 | Find the state we would get to (from the current state) by    |
-| shifting SYM.  Create a new state if no equivalent one exists |
-| already.  Used by append_states.                              |
+| shifting SYM, whose core is CORE, of fingerprint FP.  Create  |
+| a new state if no equivalent one exists already.  Used by     |
+| append_states.                                                |
 `--------------------------------------------------------------*/
 
 static state *
-get_state (symbol_number sym, size_t core_size, item_number *core)
+get_state (symbol_number sym, size_t core_size, item_number *core,
+           core_fingerprint fp)
 {
   state *s;
 
@@ -215,9 +226,9 @@ get_state (symbol_number sym, size_t core_size, item_number *core)
     fprintf (stderr, "Entering get_state, symbol = %d (%s)\n",
              sym, symbols[sym]->tag);
 
-  s = state_hash_lookup (core_size, core);
+  s = state_hash_lookup (core_size, core, fp);
   if (!s)
-    s = state_list_append (sym, core_size, core);
+    s = state_list_append (sym, core_size, core, fp);
 
   if (trace_flag & trace_automaton)
     fprintf (stderr, "Exiting get_state => %d\n", s->number);
@@ -251,10 +262,16 @@ append_states (state *s)
       shift_symbol[j] = sym;
     }
 
+  /* Have the candidate slots loaded while the first ones are looked
+     up.  */
+  for (i = 0; i < nshifts; i++)
+    state_hash_prefetch (kernel_fingerprint[shift_symbol[i]]);
+
   for (i = 0; i < nshifts; i++)
     {
       symbol_number sym = shift_symbol[i];
-      shiftset[i] = get_state (sym, kernel_size[sym], kernel_base[sym]);
+      shiftset[i] = get_state (sym, kernel_size[sym], kernel_base[sym],
+                               kernel_fingerprint[sym]);
     }
 }
 
@@ -341,7 +358,9 @@ generate_states (void)
 
   /* Create the initial state.  The 0 at the lhs is the index of the
      item of this initial rule.  */
-  state_list_append (0, 1, &initial_core);
+  state_list_append (0, 1, &initial_core,
+                     core_fingerprint_add (CORE_FINGERPRINT_EMPTY,
+                                           initial_core));
 
   /* States are queued when they are created; process them all.  */
   for (list = first_state; list; list = list->next)
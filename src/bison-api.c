@@ -0,0 +1,188 @@
+/* Library interface to Bison.
+
+   Copyright (C) 2013 Free Software Foundation, Inc.
+
+   This file is part of Bison, the GNU Compiler Compiler.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include <config.h>
+#include "system.h"
+
+#include <setjmp.h>
+
+#include "bison-api.h"
+#include "compile.h"
+#include "complain.h"
+#include "files.h"
+#include "getargs.h"
+#include "gram.h"
+#include "muscle-tab.h"
+#include "reader.h"
+#include "state.h"
+#include "symtab.h"
+#include "tables.h"
+#include "uniqstr.h"
+
+enum
+  {
+    bison_tables_size = bison_table_translate + 1,
+    bison_values_size = bison_value_table_ninf + 1
+  };
+
+struct bison_context
+{
+  /* The tables, all NULL if there are no results.  */
+  int *tables[bison_tables_size];
+  size_t sizes[bison_tables_size];
+  int values[bison_values_size];
+};
+
+bison_context *
+bison_context_new (void)
+{
+  return xzalloc (sizeof (bison_context));
+}
+
+/* Forget the results of CTX.  */
+static void
+context_clear (bison_context *ctx)
+{
+  int i;
+  for (i = 0; i < bison_tables_size; ++i)
+    free (ctx->tables[i]);
+  memset (ctx, 0, sizeof *ctx);
+}
+
+void
+bison_context_free (bison_context *ctx)
+{
+  if (ctx)
+    {
+      context_clear (ctx);
+      free (ctx);
+    }
+}
+
+/* Set the table KIND of CTX to a copy of SRC, of SIZE elements.  */
+static void
+context_table_set (bison_context *ctx, bison_table_kind kind,
+                   int const *src, size_t size)
+{
+  ctx->tables[kind] = xnmalloc (size ? size : 1, sizeof *src);
+  memcpy (ctx->tables[kind], src, size * sizeof *src);
+  ctx->sizes[kind] = size;
+}
+
+/* Copy the results of the current grammar into CTX.  The tables have
+   the layout of the muscles of the same name, see output.c.  */
+static void
+context_fill (bison_context *ctx)
+{
+  int *r1 = xnmalloc (nrules + 1, sizeof *r1);
+  int *r2 = xnmalloc (nrules + 1, sizeof *r2);
+  rule_number r;
+
+  /* The skeletons number the rules from 1.  */
+  r1[0] = r2[0] = 0;
+  for (r = 0; r < nrules; ++r)
+    {
+      r1[r + 1] = rules[r].lhs->number;
+      r2[r + 1] = rule_rhs_length (&rules[r]);
+    }
+
+  context_table_set (ctx, bison_table_pact, base, nstates);
+  context_table_set (ctx, bison_table_pgoto, base + nstates,
+                     nvectors - nstates);
+  context_table_set (ctx, bison_table_defact, yydefact, nstates);
+  context_table_set (ctx, bison_table_defgoto, yydefgoto, nvars);
+  context_table_set (ctx, bison_table_table, table, high + 1);
+  context_table_set (ctx, bison_table_check, check, high + 1);
+  context_table_set (ctx, bison_table_translate, token_translations,
+                     max_user_token_number + 1);
+  ctx->tables[bison_table_r1] = r1;
+  ctx->sizes[bison_table_r1] = nrules + 1;
+  ctx->tables[bison_table_r2] = r2;
+  ctx->sizes[bison_table_r2] = nrules + 1;
+
+  ctx->values[bison_value_final] = final_state->number;
+  ctx->values[bison_value_last] = high;
+  ctx->values[bison_value_ntokens] = ntokens;
+  ctx->values[bison_value_nnts] = nvars;
+  ctx->values[bison_value_nrules] = nrules;
+  ctx->values[bison_value_nstates] = nstates;
+  ctx->values[bison_value_maxutok] = max_user_token_number;
+  ctx->values[bison_value_pact_ninf] = base_ninf;
+  ctx->values[bison_value_table_ninf] = table_ninf;
+}
+
+/* Where fatal errors return to.  */
+static jmp_buf fatal_return;
+
+static void
+fatal_longjmp (void)
+{
+  longjmp (fatal_return, 1);
+}
+
+int
+bison_compile (bison_context *ctx, char const *name,
+               char const *buf, size_t size)
+{
+  bool volatile ok = false;
+
+  context_clear (ctx);
+
+  uniqstrs_new ();
+  muscle_init ();
+  complain_init ();
+  getargs_reset ();
+  /* There is no file to quote the source lines from.  */
+  feature_flag &= ~feature_caret;
+  current_file = grammar_file = uniqstr_new (name);
+  MUSCLE_INSERT_C_STRING ("file_name", grammar_file);
+
+  /* Memory allocated by the stage that failed may leak.  */
+  fatal_handler = fatal_longjmp;
+  if (!setjmp (fatal_return))
+    {
+      reader (buf, size);
+      if (!complaint_status)
+        compile_automaton ();
+      if (!complaint_status)
+        {
+          context_fill (ctx);
+          ok = true;
+        }
+    }
+  fatal_handler = NULL;
+
+  compile_release ();
+  uniqstrs_free ();
+  return ok ? 0 : -1;
+}
+
+int const *
+bison_table (bison_context const *ctx, bison_table_kind kind, size_t *size)
+{
+  if (size)
+    *size = ctx->sizes[kind];
+  return ctx->tables[kind];
+}
+
+int
+bison_value (bison_context const *ctx, bison_value_kind kind)
+{
+  return ctx->values[kind];
+}
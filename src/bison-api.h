@@ -0,0 +1,117 @@
+/* Library interface to Bison.
+
+   Copyright (C) 2013 Free Software Foundation, Inc.
+
+   This file is part of Bison, the GNU Compiler Compiler.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#ifndef BISON_API_H_
+# define BISON_API_H_
+
+# include <stddef.h>
+
+# ifdef __cplusplus
+extern "C" {
+# endif
+
+/* Compile grammars into parser tables without running bison(1): the
+   grammar is read from memory, and the tables are returned instead of
+   being output through the skeletons.  They are the tables of the
+   deterministic skeletons (yacc.c, lalr1.cc etc.), with the same
+   layout and the same numbering, e.g., as in yacc.c:
+
+     yyn = yypact[yystate];
+     if (yyn == YYPACT_NINF) goto yydefault;
+     yyn += yytoken;
+     if (yyn < 0 || YYLAST < yyn || yycheck[yyn] != yytoken)
+       goto yydefault;
+     yyn = yytable[yyn];
+
+   Diagnostics are reported on the standard error, as by bison(1).
+
+   All the results belong to a context, so several of them can be used
+   at the same time.  The compilation itself uses the global state of
+   Bison though: calls to bison_compile must not run concurrently, even
+   on different contexts.  */
+
+/** A compilation context: the results of the last compilation.  */
+typedef struct bison_context bison_context;
+
+/** The tables, named after their yacc.c counterparts.  */
+typedef enum
+  {
+    bison_table_pact,      /**< yypact, indexed by state.  */
+    bison_table_pgoto,     /**< yypgoto, indexed by nonterminal.  */
+    bison_table_defact,    /**< yydefact, indexed by state.  */
+    bison_table_defgoto,   /**< yydefgoto, indexed by nonterminal.  */
+    bison_table_table,     /**< yytable, of size YYLAST + 1.  */
+    bison_table_check,     /**< yycheck, of size YYLAST + 1.  */
+    bison_table_r1,        /**< yyr1, indexed by rule.  */
+    bison_table_r2,        /**< yyr2, indexed by rule.  */
+    bison_table_translate  /**< yytranslate, indexed by token number.  */
+  } bison_table_kind;
+
+/** The scalars, named after their yacc.c counterparts.  */
+typedef enum
+  {
+    bison_value_final,       /**< YYFINAL.  */
+    bison_value_last,        /**< YYLAST.  */
+    bison_value_ntokens,     /**< YYNTOKENS.  */
+    bison_value_nnts,        /**< YYNNTS.  */
+    bison_value_nrules,      /**< YYNRULES.  */
+    bison_value_nstates,     /**< YYNSTATES.  */
+    bison_value_maxutok,     /**< YYMAXUTOK.  */
+    bison_value_pact_ninf,   /**< YYPACT_NINF.  */
+    bison_value_table_ninf   /**< YYTABLE_NINF.  */
+  } bison_value_kind;
+
+/** A new context, without results.  */
+bison_context *bison_context_new (void);
+
+/** Release \a ctx and its results.  */
+void bison_context_free (bison_context *ctx);
+
+/** Compile a grammar, replacing the previous results of \a ctx.
+ *
+ *  \param ctx   the context receiving the tables.
+ *  \param name  the name of the grammar file, for the diagnostics.
+ *  \param buf   the contents of the grammar file.
+ *  \param size  the size of \a buf.
+ *
+ *  The grammar directives are honored, but since no parser is
+ *  generated, only those that change the tables matter (%define
+ *  lr.type, lr.default-reduction etc.).
+ *
+ *  \return 0 on success, or -1 if there were errors, in which case
+ *  \a ctx has no results.
+ */
+int bison_compile (bison_context *ctx, char const *name,
+                   char const *buf, size_t size);
+
+/** A table of the last successful compilation of \a ctx, or NULL if
+ *  there is none.  Its number of elements is stored in \a *size when
+ *  \a size is nonnull.  */
+int const *bison_table (bison_context const *ctx, bison_table_kind kind,
+                        size_t *size);
+
+/** A scalar of the last successful compilation of \a ctx, or 0 if
+ *  there is none.  */
+int bison_value (bison_context const *ctx, bison_value_kind kind);
+
+# ifdef __cplusplus
+}
+# endif
+
+#endif /* !BISON_API_H_ */
@@ -0,0 +1,429 @@
+/* Cache of the output files for Bison.
+
+   Copyright (C) 2013 Free Software Foundation, Inc.
+
+   This file is part of Bison, the GNU Compiler Compiler.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include <config.h>
+#include "system.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <utime.h>
+
+#include <c-ctype.h>
+#include <concat-filename.h>
+#include <filename.h>
+#include <sha1.h>
+#include <xstrndup.h>
+
+#include "cache.h"
+#include "files.h"
+#include "getargs.h"
+#include "output.h"
+
+char const *cache_dir = NULL;
+unsigned long cache_size = 64 * 1024;
+
+/* The header of the cache entries.  It is followed by the output
+   files, each one introduced by a "SIZE NAME\n" line.  */
+#define CACHE_MAGIC "bison cache 1\n"
+
+/* The key of the current grammar, in hexadecimal.  */
+static char cache_key[2 * SHA1_DIGEST_SIZE + 1];
+
+/* Statistics on the cache, for --trace=cache.  */
+static unsigned cache_hits;
+static unsigned cache_misses;
+static unsigned cache_stores;
+static unsigned cache_evictions;
+
+
+/*-------------------------------------------.
+| Computing the key of the current grammar.  |
+`-------------------------------------------*/
+
+/* Feed the string S, including its NUL terminator, to CTX.  */
+static void
+hash_string (struct sha1_ctx *ctx, char const *s)
+{
+  sha1_process_bytes (s, strlen (s) + 1, ctx);
+}
+
+/* Feed the name and the contents of the file NAME to CTX.  */
+static void
+hash_file (struct sha1_ctx *ctx, char const *name)
+{
+  FILE *in = fopen (name, "r");
+  hash_string (ctx, name);
+  if (in)
+    {
+      char buf[BUFSIZ];
+      size_t n;
+      while ((n = fread (buf, 1, sizeof buf, in)) != 0)
+        sha1_process_bytes (buf, n, ctx);
+      fclose (in);
+    }
+}
+
+static int
+strcmp_indirect (void const *a, void const *b)
+{
+  return strcmp (*(char * const *) a, *(char * const *) b);
+}
+
+/* Feed the regular files of the directory DIR (not recursively) to
+   CTX, in a stable order.  */
+static void
+hash_directory (struct sha1_ctx *ctx, char const *dir)
+{
+  DIR *d = opendir (dir);
+  char **names = NULL;
+  size_t names_alloc = 0;
+  size_t nnames = 0;
+  size_t i;
+  struct dirent *e;
+
+  hash_string (ctx, dir);
+  if (!d)
+    return;
+  while ((e = readdir (d)))
+    if (!STREQ (e->d_name, ".") && !STREQ (e->d_name, ".."))
+      {
+        if (nnames == names_alloc)
+          names = x2nrealloc (names, &names_alloc, sizeof *names);
+        names[nnames++] = xconcatenated_filename (dir, e->d_name, NULL);
+      }
+  closedir (d);
+
+  qsort (names, nnames, sizeof *names, strcmp_indirect);
+  for (i = 0; i < nnames; ++i)
+    {
+      struct stat st;
+      if (stat (names[i], &st) == 0 && S_ISREG (st.st_mode))
+        hash_file (ctx, names[i]);
+      free (names[i]);
+    }
+  free (names);
+}
+
+/* Whether the command line option OPT has no influence on the output
+   files.  If it takes an argument, it is the next one when SEPARATE
+   is set.  */
+static bool
+option_ignored (char const *opt, bool *separate)
+{
+  if (jobs_option_p (opt, separate) || STREQ (opt, "--"))
+    return true;
+  *separate = (STREQ (opt, "--cache-dir") || STREQ (opt, "--cache-size")
+               || STREQ (opt, "--incremental") || STREQ (opt, "--threads"));
+  return (*separate
+          || STRPREFIX_LIT ("--cache-dir=", opt)
+          || STRPREFIX_LIT ("--cache-size=", opt)
+          || STRPREFIX_LIT ("--incremental=", opt)
+          || STRPREFIX_LIT ("--threads=", opt)
+          || STRPREFIX_LIT ("--trace", opt)
+          || STRPREFIX_LIT ("-T", opt));
+}
+
+/* Compute CACHE_KEY.  */
+static void
+cache_key_compute (char *options[], int noptions)
+{
+  struct sha1_ctx ctx;
+  unsigned char digest[SHA1_DIGEST_SIZE];
+  char const *datadir = pkgdatadir ();
+  char const *messages = setlocale (LC_MESSAGES, NULL);
+  int i;
+
+  sha1_init_ctx (&ctx);
+  hash_string (&ctx, PACKAGE_STRING);
+  /* The report is translated.  */
+  hash_string (&ctx, messages ? messages : "");
+  for (i = 0; i < noptions; ++i)
+    {
+      bool separate;
+      if (option_ignored (options[i], &separate))
+        i += separate;
+      else
+        hash_string (&ctx, options[i]);
+    }
+  hash_file (&ctx, grammar_file);
+
+  /* The skeletons, and the M4 files they include.  */
+  hash_directory (&ctx, datadir);
+  {
+    char *m4sugar = xconcatenated_filename (datadir, "m4sugar", NULL);
+    hash_directory (&ctx, m4sugar);
+    free (m4sugar);
+  }
+  if (skeleton && IS_PATH_WITH_DIR (skeleton))
+    hash_file (&ctx, skeleton);
+
+  sha1_finish_ctx (&ctx, digest);
+  for (i = 0; i < SHA1_DIGEST_SIZE; ++i)
+    sprintf (cache_key + 2 * i, "%02x", digest[i]);
+}
+
+/* Whether NAME is the name of a cache entry.  */
+static bool
+cache_key_p (char const *name)
+{
+  int i;
+  for (i = 0; i < 2 * SHA1_DIGEST_SIZE; ++i)
+    if (!c_isxdigit (name[i]))
+      return false;
+  return !name[i];
+}
+
+
+/*----------------------.
+| Reading the entries.  |
+`----------------------*/
+
+/* Check that BUF, of SIZE bytes, is a well formed cache entry.  If
+   WRITE, also create the output files it contains.  */
+static bool
+cache_entry_walk (char const *buf, size_t size, bool write)
+{
+  char const *end = buf + size;
+  char const *p = buf + sizeof CACHE_MAGIC - 1;
+
+  if (size < sizeof CACHE_MAGIC - 1
+      || memcmp (buf, CACHE_MAGIC, sizeof CACHE_MAGIC - 1) != 0)
+    return false;
+  while (p < end)
+    {
+      char const *eol = memchr (p, '\n', end - p);
+      char *sep;
+      unsigned long len;
+      if (!eol || !c_isdigit (*p))
+        return false;
+      len = strtoul (p, &sep, 10);
+      if (*sep != ' ' || sep + 1 == eol || (size_t) (end - (eol + 1)) < len)
+        return false;
+      if (write)
+        {
+          char *name = xstrndup (sep + 1, eol - (sep + 1));
+          FILE *out = xfopen (name, "w");
+          fwrite (eol + 1, 1, len, out);
+          xfclose (out);
+          free (name);
+        }
+      p = eol + 1 + len;
+    }
+  return true;
+}
+
+bool
+cache_fetch (char *options[], int noptions)
+{
+  bool res = false;
+  char *name;
+  FILE *in;
+
+  cache_key_compute (options, noptions);
+  name = xconcatenated_filename (cache_dir, cache_key, NULL);
+  in = fopen (name, "r");
+  if (in)
+    {
+      struct stat st;
+      if (fstat (fileno (in), &st) == 0)
+        {
+          size_t size = st.st_size;
+          char *buf = xmalloc (size);
+          /* Don't create any file unless the entry is complete.  */
+          res = (fread (buf, 1, size, in) == size
+                 && cache_entry_walk (buf, size, false)
+                 && cache_entry_walk (buf, size, true));
+          free (buf);
+        }
+      fclose (in);
+    }
+
+  if (res)
+    {
+      /* Record the use of the entry, for the eviction.  */
+      utime (name, NULL);
+      ++cache_hits;
+    }
+  else
+    ++cache_misses;
+  if (trace_flag & trace_cache)
+    fprintf (stderr, "cache %s: %s\n", res ? "hit" : "miss", cache_key);
+  free (name);
+  return res;
+}
+
+
+/*----------------------.
+| Storing the entries.  |
+`----------------------*/
+
+/* Append the file NAME to the cache entry OUT.  */
+static bool
+cache_entry_append (FILE *out, char const *name)
+{
+  bool res = false;
+  FILE *in;
+  struct stat st;
+
+  if (strchr (name, '\n'))
+    return false;
+  in = fopen (name, "r");
+  if (!in)
+    return false;
+  if (fstat (fileno (in), &st) == 0 && S_ISREG (st.st_mode))
+    {
+      char buf[BUFSIZ];
+      size_t n;
+      size_t total = 0;
+      fprintf (out, "%lu %s\n", (unsigned long) st.st_size, name);
+      while ((n = fread (buf, 1, sizeof buf, in)) != 0)
+        {
+          fwrite (buf, 1, n, out);
+          total += n;
+        }
+      res = total == (size_t) st.st_size && !ferror (in);
+    }
+  fclose (in);
+  return res;
+}
+
+struct cache_entry
+{
+  char *name;
+  off_t size;
+  time_t mtime;
+};
+
+/* Sort the least recently used entries first.  */
+static int
+cache_entry_cmp (void const *a, void const *b)
+{
+  struct cache_entry const *e1 = a;
+  struct cache_entry const *e2 = b;
+  return (e1->mtime > e2->mtime) - (e1->mtime < e2->mtime);
+}
+
+/* Remove the least recently used entries until the cache is not
+   bigger than CACHE_SIZE kilobytes.  */
+static void
+cache_evict (void)
+{
+  DIR *d = opendir (cache_dir);
+  struct cache_entry *entries = NULL;
+  size_t entries_alloc = 0;
+  size_t nentries = 0;
+  uintmax_t total = 0;
+  uintmax_t limit = (uintmax_t) cache_size * 1024;
+  size_t i;
+  struct dirent *e;
+
+  if (!d)
+    return;
+  while ((e = readdir (d)))
+    if (cache_key_p (e->d_name))
+      {
+        char *name = xconcatenated_filename (cache_dir, e->d_name, NULL);
+        struct stat st;
+        if (stat (name, &st) == 0 && S_ISREG (st.st_mode))
+          {
+            if (nentries == entries_alloc)
+              entries = x2nrealloc (entries, &entries_alloc,
+                                    sizeof *entries);
+            entries[nentries].name = name;
+            entries[nentries].size = st.st_size;
+            entries[nentries].mtime = st.st_mtime;
+            ++nentries;
+            total += st.st_size;
+          }
+        else
+          free (name);
+      }
+  closedir (d);
+
+  if (limit < total)
+    qsort (entries, nentries, sizeof *entries, cache_entry_cmp);
+  for (i = 0; i < nentries; ++i)
+    {
+      if (limit < total && unlink (entries[i].name) == 0)
+        {
+          total -= entries[i].size;
+          ++cache_evictions;
+          if (trace_flag & trace_cache)
+            fprintf (stderr, "cache evict: %s\n", entries[i].name);
+        }
+      free (entries[i].name);
+    }
+  free (entries);
+}
+
+void
+cache_store (void)
+{
+  char *name = xconcatenated_filename (cache_dir, cache_key, NULL);
+  char *tmp = xconcatenated_filename (cache_dir, cache_key, ".XXXXXX");
+  bool ok;
+  int fd;
+  FILE *out = NULL;
+
+  /* Failing to fill the cache is not an error.  */
+  if (mkdir (cache_dir, 0777) != 0 && errno != EEXIST)
+    ok = false;
+  else
+    {
+      fd = mkstemp (tmp);
+      out = fd < 0 ? NULL : fdopen (fd, "w");
+      if (!out && 0 <= fd)
+        close (fd);
+      ok = !!out;
+    }
+
+  if (ok)
+    {
+      int i;
+      fputs (CACHE_MAGIC, out);
+      for (i = 0; ok && i < file_names_count; ++i)
+        ok = cache_entry_append (out, file_names[i]);
+      ok &= !ferror (out);
+      ok &= fclose (out) == 0;
+      /* Entries are created atomically, so that concurrent runs never
+         read incomplete ones.  */
+      ok = ok && rename (tmp, name) == 0;
+      if (!ok)
+        unlink (tmp);
+    }
+
+  if (ok)
+    {
+      ++cache_stores;
+      cache_evict ();
+    }
+  if (trace_flag & trace_cache)
+    fprintf (stderr, "cache %s: %s\n", ok ? "store" : "store failure",
+             cache_key);
+  free (tmp);
+  free (name);
+}
+
+void
+cache_print_stats (FILE *out)
+{
+  fprintf (out, "cache: %u hits, %u misses, %u stores, %u evictions\n",
+           cache_hits, cache_misses, cache_stores, cache_evictions);
+}
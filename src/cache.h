@@ -0,0 +1,58 @@
+/* Cache of the output files for Bison.
+
+   Copyright (C) 2013 Free Software Foundation, Inc.
+
+   This file is part of Bison, the GNU Compiler Compiler.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#ifndef CACHE_H_
+# define CACHE_H_
+
+/* The cache stores the output files of a run, keyed on everything
+   they depend upon: the version of Bison, the command line options,
+   the contents of the grammar file and of the skeletons.  When the
+   same grammar is processed again, its output files are copied from
+   the cache instead of being computed.  */
+
+/** The directory of the cache (--cache-dir), or NULL if disabled.  */
+extern char const *cache_dir;
+
+/** The maximum size of the cache, in kilobytes (--cache-size).  */
+extern unsigned long cache_size;
+
+/** Compute the key of the current grammar, and if the cache has an
+ *  entry for it, create the output files from it.
+ *
+ *  \param options   the command line options (excluding the grammar
+ *                   files), which the output depends upon.
+ *  \param noptions  size of \a options.
+ *
+ *  Must be called after the grammar file was read.
+ *
+ *  \return whether the output files were created.
+ */
+bool cache_fetch (char *options[], int noptions);
+
+/** Store the output files of the current grammar in the cache, and
+ *  evict the least recently used entries if it grew too big.
+ *
+ *  Must be called after cache_fetch, once the output files are
+ *  written.  */
+void cache_store (void);
+
+/** Report the cache statistics of this run on \a out.  */
+void cache_print_stats (FILE *out);
+
+#endif /* !CACHE_H_ */
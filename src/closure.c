@@ -24,6 +24,7 @@
 #include <bitset.h>
 #include <bitsetv-print.h>
 #include <bitsetv.h>
+#include <count-trailing-zeros.h>
 
 #include "closure.h"
 #include "derives.h"
@@ -36,15 +37,25 @@
 item_number *itemset;
 size_t nitemset;
 
-static bitset ruleset;
+/* The closure is computed as a bitmap indexed by item number, of
+   ITEMS_WORDS words.  Since it is sorted by construction, it is
+   turned into ITEMSET without any merge.  */
+static size_t items_words;
+static bitset_word *itemmap = NULL;
 
 /* internal data.  See comments before set_fderives and set_firsts.  */
 static bitsetv fderives = NULL;
 static bitsetv firsts = NULL;
 
+/* FDERIVES as item bitmaps: the items at the beginning of the rules
+   in FDERIVES, for each nonterminal.  */
+static bitset_word *fderives_items = NULL;
+
 /* Retrieve the FDERIVES/FIRSTS sets of the nonterminals numbered Var.  */
 #define FDERIVES(Var)   fderives[(Var) - ntokens]
 #define FIRSTS(Var)   firsts[(Var) - ntokens]
+#define FDERIVES_ITEMS(Var) \
+  (fderives_items + ((Var) - ntokens) * items_words)
 
 
 /*-----------------.
@@ -150,6 +161,9 @@ set_firsts (void)
 | For example, if symbol 5 can be derived as the sequence of symbols |
 | 8 3 20, and one of the rules for deriving symbol 8 is rule 4, then |
 | the [5 - NTOKENS, 4] bit in FDERIVES is set.                       |
+|                                                                    |
+| FDERIVES is then stored in FDERIVES_ITEMS, where the bits are the  |
+| items at the beginning of the rules.                               |
 `-------------------------------------------------------------------*/
 
 static void
@@ -157,6 +171,7 @@ set_fderives (void)
 {
   symbol_number i, j;
   rule_number k;
+  bitset_iterator iter;
 
   fderives = bitsetv_create (nvars, nrules, BITSET_FIXED);
 
@@ -171,7 +186,22 @@ set_fderives (void)
   if (trace_flag & trace_sets)
     print_fderives ();
 
+  fderives_items = xcalloc (nvars * items_words, sizeof *fderives_items);
+  for (i = ntokens; i < nsyms; ++i)
+    {
+      bitset_word *row = FDERIVES_ITEMS (i);
+      BITSET_FOR_EACH (iter, FDERIVES (i), k, 0)
+        {
+          item_number itemno = rules[k].rhs - ritem;
+          row[itemno / BITSET_WORD_BITS] |=
+            (bitset_word) 1 << itemno % BITSET_WORD_BITS;
+        }
+    }
+
+  bitsetv_free (fderives);
+  fderives = NULL;
   bitsetv_free (firsts);
+  firsts = NULL;
 }
 
 
@@ -181,7 +211,8 @@ new_closure (unsigned int n)
 {
   itemset = xnmalloc (n, sizeof *itemset);
 
-  ruleset = bitset_create (nrules, BITSET_FIXED);
+  items_words = (nritems + BITSET_WORD_BITS - 1) / BITSET_WORD_BITS;
+  itemmap = xnmalloc (items_words, sizeof *itemmap);
 
   set_fderives ();
 }
@@ -194,42 +225,41 @@ closure (item_number const *core, size_t n)
   /* Index over CORE. */
   size_t c;
 
-  /* A bit index over RULESET. */
-  rule_number ruleno;
-
-  bitset_iterator iter;
+  /* A word index over ITEMMAP. */
+  size_t w;
 
   if (trace_flag & trace_sets)
     print_closure ("input", core, n);
 
-  bitset_zero (ruleset);
+  memset (itemmap, 0, items_words * sizeof *itemmap);
 
+  /* The items of CORE, and the items beginning the rules they may
+     derive, one word at a time.  */
   for (c = 0; c < n; ++c)
-    if (ISVAR (ritem[core[c]]))
-      bitset_or (ruleset, ruleset, FDERIVES (ritem[core[c]]));
-
-  /* core is sorted on item index in ritem, which is sorted on rule number.
-     Compute itemset with the same sort.  */
-  nitemset = 0;
-  c = 0;
-  BITSET_FOR_EACH (iter, ruleset, ruleno, 0)
     {
-      item_number itemno = rules[ruleno].rhs - ritem;
-      while (c < n && core[c] < itemno)
+      item_number itemno = core[c];
+      itemmap[itemno / BITSET_WORD_BITS] |=
+        (bitset_word) 1 << itemno % BITSET_WORD_BITS;
+      if (ISVAR (ritem[itemno]))
         {
-          itemset[nitemset] = core[c];
-          nitemset++;
-          c++;
+          bitset_word const *row = FDERIVES_ITEMS (ritem[itemno]);
+          for (w = 0; w < items_words; ++w)
+            itemmap[w] |= row[w];
         }
-      itemset[nitemset] = itemno;
-      nitemset++;
-    };
+    }
 
-  while (c < n)
+  /* ITEMMAP is sorted on item index, as is CORE.  */
+  nitemset = 0;
+  for (w = 0; w < items_words; ++w)
     {
-      itemset[nitemset] = core[c];
-      nitemset++;
-      c++;
+      bitset_word word = itemmap[w];
+      while (word)
+        {
+          itemset[nitemset++] =
+            w * BITSET_WORD_BITS + count_trailing_zeros_l (word);
+          /* Clear the lowest bit set.  */
+          word &= word - 1;
+        }
     }
 
   if (trace_flag & trace_sets)
@@ -241,6 +271,9 @@ void
 free_closure (void)
 {
   free (itemset);
-  bitset_free (ruleset);
-  bitsetv_free (fderives);
+  itemset = NULL;
+  free (itemmap);
+  itemmap = NULL;
+  free (fderives_items);
+  fderives_items = NULL;
 }
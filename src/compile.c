@@ -0,0 +1,137 @@
+/* Compilation of a grammar into parser tables for Bison.
+
+   Copyright (C) 1984, 1986, 1989, 1992, 1995, 2000-2002, 2004-2013 Free
+   Software Foundation, Inc.
+
+   This file is part of Bison, the GNU Compiler Compiler.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include <config.h>
+#include "system.h"
+
+#include <timevar.h>
+
+#include "LR0.h"
+#include "compile.h"
+#include "complain.h"
+#include "conflicts.h"
+#include "derives.h"
+#include "files.h"
+#include "gram.h"
+#include "ielr.h"
+#include "lalr.h"
+#include "location.h"
+#include "muscle-tab.h"
+#include "nullable.h"
+#include "reader.h"
+#include "reduce.h"
+#include "scan-code.h"
+#include "scan-gram.h"
+#include "scan-skel.h"
+#include "state.h"
+#include "symtab.h"
+#include "tables.h"
+
+void
+compile_grammar (void)
+{
+  /* Find useless nonterminals and productions and reduce the grammar. */
+  timevar_push (TV_REDUCE);
+  reduce_grammar ();
+  timevar_pop (TV_REDUCE);
+}
+
+
+void
+compile_tables (void)
+{
+  /* Record other info about the grammar.  In files derives and
+     nullable.  */
+  timevar_push (TV_SETS);
+  derives_compute ();
+  nullable_compute ();
+  timevar_pop (TV_SETS);
+
+  /* Compute LR(0) parser states.  See state.h for more info.  */
+  timevar_push (TV_LR0);
+  generate_states ();
+  timevar_pop (TV_LR0);
+
+  /* Add lookahead sets to parser states.  Except when LALR(1) is
+     requested, split states to eliminate LR(1)-relative
+     inadequacies.  */
+  ielr ();
+
+  /* Find and record any conflicts: places where one token of
+     lookahead is not enough to disambiguate the parsing.  In file
+     conflicts.  Also resolve s/r conflicts based on precedence
+     declarations.  */
+  timevar_push (TV_CONFLICTS);
+  conflicts_solve ();
+  if (!muscle_percent_define_flag_if ("lr.keep-unreachable-state"))
+    {
+      state_number *old_to_new = xnmalloc (nstates, sizeof *old_to_new);
+      state_number nstates_old = nstates;
+      state_remove_unreachable_states (old_to_new);
+      lalr_update_state_numbers (old_to_new, nstates_old);
+      conflicts_update_state_numbers (old_to_new, nstates_old);
+      free (old_to_new);
+    }
+  conflicts_print ();
+  timevar_pop (TV_CONFLICTS);
+
+  /* Compute the parser tables.  */
+  timevar_push (TV_ACTIONS);
+  tables_generate ();
+  timevar_pop (TV_ACTIONS);
+
+  grammar_rules_useless_report (_("rule useless in parser due to conflicts"));
+
+  print_precedence_warnings ();
+}
+
+
+void
+compile_automaton (void)
+{
+  compile_grammar ();
+  compile_tables ();
+}
+
+
+void
+compile_release (void)
+{
+  timevar_push (TV_FREE);
+  lalr_free ();
+  nullable_free ();
+  derives_free ();
+  tables_free ();
+  states_free ();
+  reduce_free ();
+  conflicts_free ();
+  grammar_free ();
+  output_file_names_free ();
+
+  /* The scanner memory cannot be released right after parsing, as it
+     contains things such as user actions, prologue, epilogue etc.  */
+  gram_scanner_free ();
+  muscle_free ();
+  code_scanner_free ();
+  skel_scanner_free ();
+  timevar_pop (TV_FREE);
+
+  cleanup_caret ();
+}
@@ -0,0 +1,43 @@
+/* Compilation of a grammar into parser tables for Bison.
+
+   Copyright (C) 2013 Free Software Foundation, Inc.
+
+   This file is part of Bison, the GNU Compiler Compiler.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#ifndef COMPILE_H_
+# define COMPILE_H_
+
+/* The stages shared by bison(1) and by the library (see bison-api.h),
+   between reading the grammar and outputting the parser.  */
+
+/** Reduce the grammar that was read.  */
+void compile_grammar (void);
+
+/** Build the automaton of the reduced grammar, solve its conflicts
+ *  and compute the parser tables (see tables.h).  */
+void compile_tables (void);
+
+/** Reduce the grammar that was read, build its automaton, solve its
+ *  conflicts and compute the parser tables: compile_grammar and
+ *  compile_tables.  */
+void compile_automaton (void);
+
+/** Release the memory allocated for the current grammar, whether it
+ *  was compiled successfully or not, so that the next grammar starts
+ *  from a clean state.  */
+void compile_release (void);
+
+#endif /* !COMPILE_H_ */
@@ -35,6 +35,10 @@ err_status complaint_status = status_none;
 
 bool warnings_are_errors = false;
 
+bool complaint_issued = false;
+
+void (*fatal_handler) (void) = NULL;
+
 /** Diagnostics severity.  */
 typedef enum
   {
@@ -138,24 +142,29 @@ warning_argmatch (char const *arg, size_t no, size_t err)
  */
 
 void
-warnings_argmatch (char *args)
+warnings_argmatch (char const *args)
 {
   if (args)
-    for (args = strtok (args, ","); args; args = strtok (NULL, ","))
-      if (STREQ (args, "error"))
-        warnings_are_errors = true;
-      else if (STREQ (args, "no-error"))
-        {
-          warnings_are_errors = false;
-          warning_argmatch ("no-error=everything", 3, 6);
-        }
-      else
-        {
-          size_t no = STRPREFIX_LIT ("no-", args) ? 3 : 0;
-          size_t err = STRPREFIX_LIT ("error=", args + no) ? 6 : 0;
-
-          warning_argmatch (args, no, err);
-        }
+    {
+      char *copy = xstrdup (args);
+      char *arg;
+      for (arg = strtok (copy, ","); arg; arg = strtok (NULL, ","))
+        if (STREQ (arg, "error"))
+          warnings_are_errors = true;
+        else if (STREQ (arg, "no-error"))
+          {
+            warnings_are_errors = false;
+            warning_argmatch ("no-error=everything", 3, 6);
+          }
+        else
+          {
+            size_t no = STRPREFIX_LIT ("no-", arg) ? 3 : 0;
+            size_t err = STRPREFIX_LIT ("error=", arg + no) ? 6 : 0;
+
+            warning_argmatch (arg, no, err);
+          }
+      free (copy);
+    }
   else
     warning_argmatch ("all", 0, 0);
 }
@@ -172,6 +181,9 @@ complain_init (void)
     Wconflicts_sr | Wconflicts_rr | Wdeprecated | Wother;
 
   size_t b;
+  complaint_status = status_none;
+  complaint_issued = false;
+  warnings_are_errors = false;
   for (b = 0; b < warnings_size; ++b)
     warnings_flag[b] = (1 << b & warnings_default
                         ? severity_warning
@@ -208,6 +220,17 @@ warning_is_unset (warnings flags)
   return true;
 }
 
+warnings
+warnings_enabled (void)
+{
+  int res = Wnone;
+  size_t b;
+  for (b = 0; b < warnings_size; ++b)
+    if (severity_warning <= warnings_flag[b])
+      res |= 1 << b;
+  return res;
+}
+
 /** Display a "[-Wyacc]" like message on \a f.  */
 
 static void
@@ -300,11 +323,16 @@ complains (const location *loc, warnings flags, const char *message,
         : _("warning");
       if (severity_error <= s && ! complaint_status)
         complaint_status = status_warning_as_error;
+      complaint_issued = true;
       error_message (loc, flags, prefix, message, args);
     }
 
   if (flags & fatal)
-    exit (EXIT_FAILURE);
+    {
+      if (fatal_handler)
+        fatal_handler ();
+      exit (EXIT_FAILURE);
+    }
 }
 
 void
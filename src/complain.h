@@ -66,14 +66,14 @@ void warning_argmatch (char const *arg, size_t no, size_t err);
  *  \param args     comma separated list of effective subarguments to decode.
  *                  If 0, then activate all the flags.
  */
-void warnings_argmatch (char *args);
+void warnings_argmatch (char const *args);
 
 
 /*-----------.
 | complain.  |
 `-----------*/
 
-/** Initialize this module.  */
+/** Initialize this module, and reset the complaint status.  */
 void complain_init (void);
 
 typedef enum
@@ -106,6 +106,9 @@ typedef enum
     (Never enabled, never disabled). */
 bool warning_is_unset (warnings flags);
 
+/** The warnings that are enabled, possibly as errors.  */
+warnings warnings_enabled (void);
+
 /** Make a complaint, with maybe a location.  */
 void complain (location const *loc, warnings flags, char const *message, ...)
   __attribute__ ((__format__ (__printf__, 3, 4)));
@@ -141,4 +144,11 @@ typedef enum
 /** Whether an error was reported.  */
 extern err_status complaint_status;
 
+/** Whether any diagnostic (including a warning) was reported.  */
+extern bool complaint_issued;
+
+/** If nonnull, called on fatal errors, before exiting.  The library
+    (see bison-api.h) uses it to longjmp back to its caller.  */
+extern void (*fatal_handler) (void);
+
 #endif /* !COMPLAIN_H_ */
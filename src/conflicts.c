@@ -621,7 +621,12 @@ conflicts_print (void)
 void
 conflicts_free (void)
 {
+  expected_sr_conflicts = -1;
+  expected_rr_conflicts = -1;
+  if (!conflicts)
+    return;
   free (conflicts);
+  conflicts = NULL;
   bitset_free (shift_set);
   bitset_free (lookahead_set);
   obstack_free (&solved_conflicts_obstack, NULL);
@@ -115,6 +115,8 @@ derives_compute (void)
 void
 derives_free (void)
 {
-  free (derives[0]);
+  if (derives)
+    free (derives[0]);
   free (derives);
+  derives = NULL;
 }
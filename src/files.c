@@ -50,9 +50,8 @@ char *spec_xml_file = NULL;      /* for -x. */
 char *spec_defines_file = NULL;  /* for --defines. */
 char *parser_file_name;
 
-/* All computed output file names.  */
-static char **file_names = NULL;
-static int file_names_count = 0;
+char **file_names = NULL;
+int file_names_count = 0;
 
 uniqstr grammar_file = NULL;
 uniqstr current_file = NULL;
@@ -350,8 +349,11 @@ compute_output_file_names (void)
     }
 
   free (all_but_tab_ext);
+  all_but_tab_ext = NULL;
   free (src_extension);
+  src_extension = NULL;
   free (header_extension);
+  header_extension = NULL;
 }
 
 void
@@ -392,16 +394,28 @@ void
 output_file_names_free (void)
 {
   free (all_but_ext);
+  all_but_ext = NULL;
   free (spec_verbose_file);
+  spec_verbose_file = NULL;
   free (spec_graph_file);
+  spec_graph_file = NULL;
   free (spec_xml_file);
+  spec_xml_file = NULL;
   free (spec_defines_file);
+  spec_defines_file = NULL;
   free (parser_file_name);
+  parser_file_name = NULL;
   free (dir_prefix);
+  dir_prefix = NULL;
   {
     int i;
     for (i = 0; i < file_names_count; i++)
       free (file_names[i]);
   }
   free (file_names);
+  file_names = NULL;
+  file_names_count = 0;
+  spec_outfile = NULL;
+  spec_file_prefix = NULL;
+  spec_name_prefix = NULL;
 }
@@ -50,6 +50,11 @@ extern char *spec_defines_file;
 /* Directory prefix of output file names.  */
 extern char *dir_prefix;
 
+/* All the output file names, and their number.  Conflicting outputs,
+   redirected to /dev/null, are not listed.  */
+extern char **file_names;
+extern int file_names_count;
+
 /* The file name as given on the command line.
    Not named "input_file" because Flex uses this name for an argument,
    and therefore GCC warns about a name clash. */
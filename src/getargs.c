@@ -25,13 +25,16 @@
 #include <argmatch.h>
 #include <c-strcase.h>
 #include <configmake.h>
+#include <errno.h>
 #include <error.h>
 #include <getopt.h>
 #include <progname.h>
 
+#include "cache.h"
 #include "complain.h"
 #include "files.h"
 #include "getargs.h"
+#include "incremental.h"
 #include "muscle-tab.h"
 #include "quote.h"
 #include "uniqstr.h"
@@ -46,7 +49,13 @@ bool yacc_flag; /* for -y */
 bool nondeterministic_parser = false;
 bool glr_parser = false;
 
-int feature_flag = feature_caret;
+int max_jobs = 1;
+int max_threads = 1;
+
+/* The features enabled unless --feature says otherwise.  */
+enum { feature_default = feature_caret | feature_m4_frozen };
+
+int feature_flag = feature_default;
 int report_flag = report_none;
 int trace_flag = trace_none;
 
@@ -107,19 +116,25 @@ flag_argmatch (const char *option,
  *  \param flags    the flags to update
  *  \param args     comma separated list of effective subarguments to decode.
  *                  If 0, then activate all the flags.
+ *                  Not modified, as it is decoded again for each grammar.
  */
 static void
 flags_argmatch (const char *option,
                 const char * const keys[], const int values[],
-                int all, int *flags, char *args)
+                int all, int *flags, char const *args)
 {
   if (args)
-    for (args = strtok (args, ","); args; args = strtok (NULL, ","))
-      {
-        size_t no = STRPREFIX_LIT ("no-", args) ? 3 : 0;
-        flag_argmatch (option, keys,
-                       values, all, flags, args, no);
-      }
+    {
+      char *copy = xstrdup (args);
+      char *arg;
+      for (arg = strtok (copy, ","); arg; arg = strtok (NULL, ","))
+        {
+          size_t no = STRPREFIX_LIT ("no-", arg) ? 3 : 0;
+          flag_argmatch (option, keys,
+                         values, all, flags, arg, no);
+        }
+      free (copy);
+    }
   else
     *flags |= all;
 }
@@ -192,6 +207,9 @@ static const char * const trace_args[] =
   "skeleton   - skeleton postprocessing",
   "time       - time consumption",
   "ielr       - IELR conversion",
+  "cache      - output cache hits, misses and evictions",
+  "tables     - size and packing time of the parser tables",
+  "incremental - reuse of the automaton of a previous run",
   "all        - all of the above",
   0
 };
@@ -212,6 +230,9 @@ static const int trace_types[] =
   trace_skeleton,
   trace_time,
   trace_ielr,
+  trace_cache,
+  trace_tables,
+  trace_incremental,
   trace_all
 };
 
@@ -226,6 +247,7 @@ static const char * const feature_args[] =
 {
   "none",
   "caret", "diagnostics-show-caret",
+  "m4-frozen",
   "all",
   0
 };
@@ -234,6 +256,7 @@ static const int feature_types[] =
 {
   feature_none,
   feature_caret, feature_caret,
+  feature_m4_frozen,
   feature_all
 };
 
@@ -258,11 +281,12 @@ usage (int status)
          A --long option is required.
          Otherwise, add exceptions to ../build-aux/cross-options.pl.  */
 
-      printf (_("Usage: %s [OPTION]... FILE\n"), program_name);
+      printf (_("Usage: %s [OPTION]... FILE...\n"), program_name);
       fputs (_("\
 Generate a deterministic LR or generalized LR (GLR) parser employing\n\
 LALR(1), IELR(1), or canonical LR(1) parser tables.  IELR(1) and\n\
 canonical LR(1) support is experimental.\n\
+When several FILEs are given, each of them is processed in turn.\n\
 \n\
 "), stdout);
 
@@ -281,6 +305,8 @@ Operation modes:\n\
       --print-localedir      output directory containing locale-dependent data\n\
       --print-datadir        output directory containing skeletons and XSLT\n\
   -y, --yacc                 emulate POSIX Yacc\n\
+  -j, --jobs=N               process up to N grammar files at once\n\
+      --threads=N            split the states with up to N threads\n\
   -W, --warnings[=CATEGORY]  report the warnings falling in CATEGORY\n\
   -f, --feature[=FEATURE]    activate miscellaneous features\n\
 \n\
@@ -316,6 +342,10 @@ Output:\n\
   -g, --graph[=FILE]         also output a graph of the automaton\n\
   -x, --xml[=FILE]           also output an XML report of the automaton\n\
                              (the XML schema is experimental)\n\
+      --cache-dir=DIR        reuse the output files cached in DIR\n\
+      --cache-size=SIZE      limit the cache to SIZE kilobytes\n\
+      --incremental=FILE     reuse the automaton saved in FILE if only\n\
+                             the actions changed\n\
 "), stdout);
       putc ('\n', stdout);
 
@@ -350,6 +380,7 @@ THINGS is a list of comma separated words that can include:\n\
       fputs (_("\
 FEATURE is a list of comma separated words that can include:\n\
   'caret'        show errors with carets\n\
+  'm4-frozen'    reload the frozen state of m4sugar if installed\n\
   'all'          all of the above\n\
   'none'         disable all of the above\n\
   "), stdout);
@@ -466,6 +497,7 @@ static char const short_options[] =
   "f::"
   "g::"
   "h"
+  "j:"
   "k"
   "l"
   "o:"
@@ -483,7 +515,11 @@ enum
   LOCATIONS_OPTION = CHAR_MAX + 1,
   PRINT_LOCALEDIR_OPTION,
   PRINT_DATADIR_OPTION,
-  REPORT_FILE_OPTION
+  REPORT_FILE_OPTION,
+  CACHE_DIR_OPTION,
+  CACHE_SIZE_OPTION,
+  INCREMENTAL_OPTION,
+  THREADS_OPTION
 };
 
 static struct option const long_options[] =
@@ -507,6 +543,9 @@ static struct option const long_options[] =
   { "report",      required_argument,   0,   'r' },
   { "report-file", required_argument,   0,   REPORT_FILE_OPTION },
   { "verbose",     no_argument,         0,   'v' },
+  { "cache-dir",   required_argument,   0,   CACHE_DIR_OPTION },
+  { "cache-size",  required_argument,   0,   CACHE_SIZE_OPTION },
+  { "incremental", required_argument,   0,   INCREMENTAL_OPTION },
 
   /* Hidden. */
   { "trace",         optional_argument,   0,     'T' },
@@ -516,6 +555,8 @@ static struct option const long_options[] =
   { "feature",     optional_argument,   0,   'f' },
 
   /* Operation modes.  */
+  { "jobs",               required_argument, 0, 'j' },
+  { "threads",            required_argument, 0, THREADS_OPTION },
   { "fixed-output-files", no_argument,  0,   'y' },
   { "yacc",               no_argument,  0,   'y' },
 
@@ -554,10 +595,39 @@ command_line_location (void)
 
 
 void
-getargs (int argc, char *argv[])
+getargs_reset (void)
+{
+  defines_flag = false;
+  graph_flag = false;
+  xml_flag = false;
+  no_lines_flag = false;
+  token_table_flag = false;
+  yacc_flag = false;
+  nondeterministic_parser = false;
+  glr_parser = false;
+  feature_flag = feature_default;
+  report_flag = report_none;
+  trace_flag = trace_none;
+  skeleton_prio = default_prio;
+  skeleton = NULL;
+  language_prio = default_prio;
+  language = &valid_languages[0];
+}
+
+
+int
+getargs (int argc, char *argv[], int job, int *noptions)
 {
   int c;
+  /* An option that names a single output file, if any.  */
+  char const *single_output_option = NULL;
+
+  /* Start from the default settings: the previous grammar may have
+     changed them with its directives.  */
+  getargs_reset ();
 
+  /* Have getopt start over.  */
+  optind = 0;
   while ((c = getopt_long (argc, argv, short_options, long_options, NULL))
          != -1)
     switch (c)
@@ -572,8 +642,8 @@ getargs (int argc, char *argv[])
       case 'D': /* -DNAME[=(VALUE|"VALUE"|{VALUE})]. */
       case 'F': /* -FNAME[=(VALUE|"VALUE"|{VALUE})]. */
         {
-          char *name = optarg;
-          char *value = strchr (optarg, '=');
+          char *name = xstrdup (optarg);
+          char *value = strchr (name, '=');
           muscle_kind kind = muscle_keyword;
           if (value)
             {
@@ -596,6 +666,7 @@ getargs (int argc, char *argv[])
                                         kind, value ? value : "",
                                         c == 'D' ? MUSCLE_PERCENT_DEFINE_D
                                                  : MUSCLE_PERCENT_DEFINE_F);
+          free (name);
         }
         break;
 
@@ -627,6 +698,7 @@ getargs (int argc, char *argv[])
 
       case 'b':
         spec_file_prefix = AS_FILE_NAME (optarg);
+        single_output_option = "--file-prefix";
         break;
 
       case 'd':
@@ -634,6 +706,7 @@ getargs (int argc, char *argv[])
         defines_flag = true;
         if (optarg)
           {
+            single_output_option = "--defines";
             free (spec_defines_file);
             spec_defines_file = xstrdup (AS_FILE_NAME (optarg));
           }
@@ -643,6 +716,7 @@ getargs (int argc, char *argv[])
         graph_flag = true;
         if (optarg)
           {
+            single_output_option = "--graph";
             free (spec_graph_file);
             spec_graph_file = xstrdup (AS_FILE_NAME (optarg));
           }
@@ -651,6 +725,21 @@ getargs (int argc, char *argv[])
       case 'h':
         usage (EXIT_SUCCESS);
 
+      case 'j':
+        {
+          char *end;
+          long n;
+          errno = 0;
+          n = strtol (optarg, &end, 10);
+          if (errno || end == optarg || *end || n < 1 || INT_MAX < n)
+            {
+              error (0, 0, _("invalid number of jobs: %s"), quote (optarg));
+              usage (EXIT_FAILURE);
+            }
+          max_jobs = n;
+        }
+        break;
+
       case 'k':
         token_table_flag = true;
         break;
@@ -661,6 +750,7 @@ getargs (int argc, char *argv[])
 
       case 'o':
         spec_outfile = AS_FILE_NAME (optarg);
+        single_output_option = "--output";
         break;
 
       case 'p':
@@ -686,6 +776,7 @@ getargs (int argc, char *argv[])
         xml_flag = true;
         if (optarg)
           {
+            single_output_option = "--xml";
             free (spec_xml_file);
             spec_xml_file = xstrdup (AS_FILE_NAME (optarg));
           }
@@ -694,6 +785,7 @@ getargs (int argc, char *argv[])
       case 'y':
         warning_argmatch ("error=yacc", 0, 6);
         yacc_flag = true;
+        single_output_option = "--yacc";
         break;
 
       case LOCATIONS_OPTION:
@@ -710,25 +802,89 @@ getargs (int argc, char *argv[])
         exit (EXIT_SUCCESS);
 
       case REPORT_FILE_OPTION:
+        single_output_option = "--report-file";
         free (spec_verbose_file);
         spec_verbose_file = xstrdup (AS_FILE_NAME (optarg));
         break;
 
+      case CACHE_DIR_OPTION:
+        cache_dir = optarg;
+        break;
+
+      case CACHE_SIZE_OPTION:
+        {
+          char *end;
+          errno = 0;
+          cache_size = strtoul (optarg, &end, 10);
+          if (errno || end == optarg || *end)
+            {
+              error (0, 0, _("invalid cache size: %s"), quote (optarg));
+              usage (EXIT_FAILURE);
+            }
+        }
+        break;
+
+      case INCREMENTAL_OPTION:
+        incremental_file = optarg;
+        break;
+
+      case THREADS_OPTION:
+        {
+          char *end;
+          long n;
+          errno = 0;
+          n = strtol (optarg, &end, 10);
+          if (errno || end == optarg || *end || n < 1 || INT_MAX < n)
+            {
+              error (0, 0, _("invalid number of threads: %s"),
+                     quote (optarg));
+              usage (EXIT_FAILURE);
+            }
+          max_threads = n;
+        }
+        break;
+
       default:
         usage (EXIT_FAILURE);
       }
 
-  if (argc - optind != 1)
+  if (argc - optind < 1)
+    {
+      error (0, 0, _("%s: missing operand"), quotearg_colon (argv[argc - 1]));
+      usage (EXIT_FAILURE);
+    }
+
+  if (1 < argc - optind && single_output_option)
     {
-      if (argc - optind < 1)
-        error (0, 0, _("%s: missing operand"), quotearg_colon (argv[argc - 1]));
-      else
-        error (0, 0, _("extra operand %s"), quote (argv[optind + 1]));
+      error (0, 0, _("%s cannot be used with several grammar files"),
+             quote (single_output_option));
       usage (EXIT_FAILURE);
     }
 
-  current_file = grammar_file = uniqstr_new (argv[optind]);
+  current_file = grammar_file = uniqstr_new (argv[optind + job]);
   MUSCLE_INSERT_C_STRING ("file_name", grammar_file);
+  *noptions = optind - 1;
+  return argc - optind;
+}
+
+bool
+jobs_option_p (char const *arg, bool *separate)
+{
+  size_t len;
+  *separate = false;
+  if (arg[0] == '-' && arg[1] == 'j')
+    {
+      *separate = !arg[2];
+      return true;
+    }
+  /* getopt_long accepts the abbreviations of --jobs.  */
+  if (!STRPREFIX_LIT ("--j", arg))
+    return false;
+  len = strcspn (arg, "=");
+  if (sizeof "--jobs" - 1 < len || strncmp (arg, "--jobs", len) != 0)
+    return false;
+  *separate = !arg[len];
+  return true;
 }
 
 void
@@ -54,6 +54,16 @@ extern bool glr_parser;
 
 extern bool nondeterministic_parser;
 
+/* MAX_JOBS is the maximum number of grammar files processed in
+   parallel (-j).  */
+
+extern int max_jobs;
+
+/* MAX_THREADS is the maximum number of threads splitting the states
+   of IELR and canonical LR parsers (--threads).  */
+
+extern int max_threads;
+
 
 /* --language.  */
 struct bison_language
@@ -103,6 +113,9 @@ enum trace
     trace_m4        = 1 << 10, /**< M4 traces. */
     trace_muscles   = 1 << 11, /**< M4 definitions of the muscles. */
     trace_ielr      = 1 << 12, /**< IELR conversion. */
+    trace_cache     = 1 << 13, /**< Output cache. */
+    trace_tables    = 1 << 14, /**< Packing of the parser tables. */
+    trace_incremental = 1 << 15, /**< Reuse of the automaton. */
     trace_all       = ~0       /**< All of the above.  */
   };
 /** What debug items bison displays during its run.  */
@@ -114,20 +127,39 @@ extern int trace_flag;
 
 enum feature
   {
-    feature_none  = 0,         /**< No additional feature.  */
-    feature_caret = 1 << 0,    /**< Enhance the output of errors with carets.  */
-    feature_all   = ~0         /**< All above features.  */
+    feature_none      = 0,      /**< No additional feature.  */
+    feature_caret     = 1 << 0, /**< Enhance the output of errors with carets.  */
+    feature_m4_frozen = 1 << 1, /**< Reload M4's frozen state of m4sugar.  */
+    feature_all       = ~0      /**< All above features.  */
   };
 /** What additional features to use.  */
 extern int feature_flag;
 
 
-/** Process the command line arguments.
+/** Reset the settings to their defaults, as if no option was given.  */
+void getargs_reset (void);
+
+/** Process the command line arguments for one of the grammar files.
  *
  *  \param argc   size of \a argv
- *  \param argv   list of arguments.
+ *  \param argv   list of arguments.  Not modified, except for the
+ *                order of its elements.
+ *  \param job    index of the grammar file to process among the
+ *                operands.
+ *  \param noptions  set to the number of arguments, after \a argv[0],
+ *                that are options or their arguments.
+ *
+ *  Resets the settings to their defaults before applying the options,
+ *  so that each grammar file starts afresh.
+ *
+ *  \return the number of grammar files.
  */
-void getargs (int argc, char *argv[]);
+int getargs (int argc, char *argv[], int job, int *noptions);
+
+/** Whether the command line argument \a arg is a -j/--jobs option.
+ *  Set \a *separate if its argument is the next command line
+ *  argument.  */
+bool jobs_option_p (char const *arg, bool *separate);
 
 /* Used by parse-gram.y.  */
 void language_argmatch (char const *arg, int prio, location loc);
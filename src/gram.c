@@ -302,8 +302,17 @@ grammar_free (void)
 {
   if (ritem)
     free (ritem - 1);
+  ritem = NULL;
+  nritems = 0;
   free (rules);
+  rules = NULL;
+  nrules = 0;
   free (token_translations);
+  token_translations = NULL;
+  max_user_token_number = 256;
+  nsyms = 0;
+  ntokens = 1;
+  nvars = 0;
   /* Free the symbol table data structure.  */
   symbols_free ();
   free_merger_functions ();
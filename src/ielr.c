@@ -23,8 +23,16 @@
 #include "ielr.h"
 
 #include <bitset.h>
+#include <hash.h>
 #include <timevar.h>
 
+#if HAVE_PTHREAD_H && HAVE_PTHREAD_CREATE
+# include <pthread.h>
+# define IELR_THREADS 1
+#else
+# define IELR_THREADS 0
+#endif
+
 #include "AnnotationList.h"
 #include "derives.h"
 #include "getargs.h"
@@ -334,7 +342,8 @@ ielr_compute_predecessors (void)
  * \post
  *   - \c *follow_kernel_itemsp and \c *always_followsp were computed by
  *     \c ielr_compute_follow_kernel_items and
- *     \c ielr_compute_always_follows.
+ *     \c ielr_compute_always_follows, and converted by \c bitsetv_adapt:
+ *     their rows may be sparse bitsets.
  *   - Iff <tt>predecessorsp != NULL</tt>, then \c *predecessorsp was computed
  *     by \c ielr_compute_predecessors.
  */
@@ -361,6 +370,20 @@ ielr_compute_auxiliary_tables (bitsetv *follow_kernel_itemsp,
   }
   free (edges);
   free (edge_counts);
+
+  /* On large grammars, both are sparse, and they are kept during the
+     whole split of the states.  From now on, they are only tested,
+     iterated over, and copied into fixed bitsets, which the sparse
+     bitsets support.  The threads of ielr_split_states do not test
+     them: unlike iterating, testing updates the cache of the sparse
+     bitsets.  */
+  *follow_kernel_itemsp = bitsetv_adapt (*follow_kernel_itemsp);
+  *always_followsp = bitsetv_adapt (*always_followsp);
+  if ((trace_flag & trace_bitsets) && ngotos)
+    fprintf (stderr, "ielr: follow_kernel_items: %s, always_follows: %s\n",
+             bitset_type_name_get ((*follow_kernel_itemsp)[0]),
+             bitset_type_name_get ((*always_followsp)[0]));
+
   if (predecessorsp)
     *predecessorsp = ielr_compute_predecessors ();
 }
@@ -556,7 +579,8 @@ typedef struct state_list {
   bool recomputedAsSuccessor;
   /**
    * \c NULL iff all lookahead sets are empty.  <tt>lookaheads[i] = NULL</tt>
-   * iff the lookahead set on item \c i is empty.
+   * iff the lookahead set on item \c i is empty.  The lookahead sets are
+   * interned (see \c lookaheads_intern): they must not be modified.
    */
   bitset *lookaheads;
   /**
@@ -566,8 +590,116 @@ typedef struct state_list {
    */
   struct state_list *lr0Isocore;
   struct state_list *nextIsocore;
+  /** Incremented whenever lookaheads are merged into this state.  */
+  unsigned int lookaheadsChanges;
 } state_list;
 
+/**
+ * An interned lookahead set, and the number of items of the states of
+ * \c ielr_split_states that share it.
+ */
+typedef struct
+{
+  bitset set;
+  size_t refs;
+} interned_lookaheads;
+
+/**
+ * The distinct lookahead sets of the items of the states, so that the
+ * items with the same lookaheads share them: in canonical LR(1) most of
+ * them are identical.  Only the main thread modifies it, while the
+ * workers of \c ielr_successors_compute_all are idle.
+ */
+static Hash_table *lookaheads_table = NULL;
+
+static size_t
+lookaheads_hash (void const *m, size_t tablesize)
+{
+  interned_lookaheads const *l = m;
+  size_t res = 0;
+  bitset_iterator iter;
+  bitset_bindex i;
+  BITSET_FOR_EACH (iter, l->set, i, 0)
+    res = res * 31 + i;
+  return res % tablesize;
+}
+
+static bool
+lookaheads_compare (void const *m1, void const *m2)
+{
+  interned_lookaheads const *l1 = m1;
+  interned_lookaheads const *l2 = m2;
+  return bitset_equal_p (l1->set, l2->set);
+}
+
+static void
+lookaheads_free (void *m)
+{
+  interned_lookaheads *l = m;
+  bitset_free (l->set);
+  free (l);
+}
+
+static void
+lookaheads_table_new (void)
+{
+  lookaheads_table = hash_initialize (nstates, NULL,
+                                      lookaheads_hash, lookaheads_compare,
+                                      lookaheads_free);
+  if (!lookaheads_table)
+    xalloc_die ();
+}
+
+static void
+lookaheads_table_free (void)
+{
+  hash_free (lookaheads_table);
+  lookaheads_table = NULL;
+}
+
+/**
+ * \pre
+ *   - \c set is not empty.
+ * \post
+ *   - The result is the interned lookahead set equal to \c set, which is
+ *     unchanged.  It must be released with \c lookaheads_release.
+ */
+static bitset
+lookaheads_intern (bitset set)
+{
+  interned_lookaheads probe;
+  interned_lookaheads *res;
+  probe.set = set;
+  res = hash_lookup (lookaheads_table, &probe);
+  if (!res)
+    {
+      res = xmalloc (sizeof *res);
+      res->set = bitset_create (ntokens, BITSET_FIXED);
+      bitset_copy (res->set, set);
+      res->refs = 0;
+      if (!hash_insert (lookaheads_table, res))
+        xalloc_die ();
+    }
+  ++res->refs;
+  return res->set;
+}
+
+/** Release \c set, which was returned by \c lookaheads_intern.  */
+static void
+lookaheads_release (bitset set)
+{
+  interned_lookaheads probe;
+  interned_lookaheads *l;
+  probe.set = set;
+  l = hash_lookup (lookaheads_table, &probe);
+  aver (l && l->set == set);
+  if (!--l->refs)
+    {
+      hash_delete (lookaheads_table, l);
+      lookaheads_free (l);
+    }
+}
+
 /**
  * \pre
  *   - \c follow_kernel_items and \c always_follows were computed by
@@ -802,18 +934,27 @@ ielr_compute_state (bitsetv follow_kernel_items, bitsetv always_follows,
           for (i = 0; i < t->nitems; ++i)
             if (!bitset_empty_p (lookaheads[i]))
               {
-                if (!(*this_isocorep)->lookaheads[i])
-                  (*this_isocorep)->lookaheads[i] =
-                    bitset_create (ntokens, BITSET_FIXED);
-                bitset_andn (lookaheads[i],
-                             lookaheads[i], (*this_isocorep)->lookaheads[i]);
-                bitset_or ((*this_isocorep)->lookaheads[i],
-                           lookaheads[i], (*this_isocorep)->lookaheads[i]);
+                /* The lookahead sets are shared: replace the set of the
+                   item instead of adding the new lookaheads to it.  */
+                bitset old = (*this_isocorep)->lookaheads[i];
+                if (old)
+                  bitset_andn (lookaheads[i], lookaheads[i], old);
                 if (!bitset_empty_p (lookaheads[i]))
-                  new_lookaheads = true;
+                  {
+                    new_lookaheads = true;
+                    if (old)
+                      bitset_or (lookaheads[i], lookaheads[i], old);
+                    (*this_isocorep)->lookaheads[i] =
+                      lookaheads_intern (lookaheads[i]);
+                    if (old)
+                      lookaheads_release (old);
+                  }
               }
         }
 
+      if (new_lookaheads)
+        ++(*this_isocorep)->lookaheadsChanges;
+
       /* If new lookaheads were merged, propagate those lookaheads to the
          successors, possibly splitting them.  If *tp is being recomputed for
          the first time, this isn't necessary because the main
@@ -923,21 +1064,212 @@ ielr_compute_state (bitsetv follow_kernel_items, bitsetv always_follows,
             xnmalloc (t->nitems, sizeof (*last_statep)->lookaheads);
           for (i = 0; i < t->nitems; ++i)
             {
-              if (bitset_empty_p (lookaheads[i]))
-                (*last_statep)->lookaheads[i] = NULL;
-              else
-                {
-                  (*last_statep)->lookaheads[i] =
-                    bitset_create (ntokens, BITSET_FIXED);
-                  bitset_copy ((*last_statep)->lookaheads[i], lookaheads[i]);
-                }
+              (*last_statep)->lookaheads[i] =
+                bitset_empty_p (lookaheads[i])
+                ? NULL
+                : lookaheads_intern (lookaheads[i]);
             }
         }
       (*last_statep)->lr0Isocore = lr0_isocore;
       (*last_statep)->nextIsocore = old_isocore;
+      (*last_statep)->lookaheadsChanges = 0;
     }
 }
 
+/**
+ * The lookaheads that a state propagates to its transition successors,
+ * which \c ielr_split_states may compute in parallel.
+ */
+typedef struct
+{
+  bitsetv follow_kernel_items;
+  bitsetv always_follows;
+  AnnotationList **annotation_lists;
+  /** The state whose successors are computed.  */
+  state_list *s;
+  /**
+   * For each transition \c i of \c s, the lookahead filter and the
+   * lookaheads computed by \c ielr_compute_lookaheads, in slot
+   * <tt>i % nslots</tt>.  There is a single slot, reused for all the
+   * transitions, in the sequential mode, and one per thread otherwise.
+   */
+  bitsetv *lookahead_filters;
+  bitsetv *lookaheads;
+  int nslots;
+#if IELR_THREADS
+  /** The workers, and the number of them.  */
+  pthread_t *threads;
+  int nthreads;
+  /** Protects the members below.  */
+  pthread_mutex_t lock;
+  /** Signaled when transitions are to be computed, or to quit.  */
+  pthread_cond_t work;
+  /** Signaled when all the transitions are computed.  */
+  pthread_cond_t finished;
+  /** The first transition of \c s to compute, and the number of them.  */
+  int first;
+  int num;
+  /** The next transition to compute, and the number computed.  */
+  int next;
+  int done;
+  bool quit;
+#endif
+} ielr_successors;
+
+/**
+ * \pre
+ *   - \c self->s and its transitions were set.
+ * \post
+ *   - The lookahead filter and the lookaheads for transition \c i of
+ *     <tt>self->s</tt> are in slot \c slot.
+ */
+static void
+ielr_successors_compute (ielr_successors *self, int i, int slot)
+{
+  state *t = self->s->state->transitions->states[i];
+  if (self->annotation_lists)
+    AnnotationList__computeLookaheadFilter (
+      self->annotation_lists[t->state_list->lr0Isocore->state->number],
+      t->nitems, self->lookahead_filters[slot]);
+  else
+    bitsetv_ones (self->lookahead_filters[slot]);
+  ielr_compute_lookaheads (self->follow_kernel_items, self->always_follows,
+                           self->s, t, self->lookahead_filters[slot],
+                           self->lookaheads[slot]);
+}
+
+#if IELR_THREADS
+
+/** Compute transitions until told to quit.  */
+static void *
+ielr_successors_worker (void *arg)
+{
+  ielr_successors *self = arg;
+  pthread_mutex_lock (&self->lock);
+  for (;;)
+    {
+      int i;
+      while (!self->quit && self->num <= self->next)
+        pthread_cond_wait (&self->work, &self->lock);
+      if (self->quit)
+        break;
+      i = self->next++;
+      pthread_mutex_unlock (&self->lock);
+      ielr_successors_compute (self, self->first + i, i);
+      pthread_mutex_lock (&self->lock);
+      if (++self->done == self->num)
+        pthread_cond_signal (&self->finished);
+    }
+  pthread_mutex_unlock (&self->lock);
+  return NULL;
+}
+
+/**
+ * \pre
+ *   - \c first is a multiple of <tt>self->nslots</tt>.
+ * \post
+ *   - The lookaheads for the transitions of \c s from \c first, as many as
+ *     there are slots, are in their slots.  The calling thread computes
+ *     some of them too.
+ */
+static void
+ielr_successors_compute_all (ielr_successors *self, state_list *s, int first)
+{
+  pthread_mutex_lock (&self->lock);
+  self->s = s;
+  self->first = first;
+  self->num = s->state->transitions->num - first;
+  if (self->nslots < self->num)
+    self->num = self->nslots;
+  self->next = 0;
+  self->done = 0;
+  pthread_cond_broadcast (&self->work);
+  while (self->next < self->num)
+    {
+      int i = self->next++;
+      pthread_mutex_unlock (&self->lock);
+      ielr_successors_compute (self, first + i, i);
+      pthread_mutex_lock (&self->lock);
+      ++self->done;
+    }
+  while (self->done < self->num)
+    pthread_cond_wait (&self->finished, &self->lock);
+  pthread_mutex_unlock (&self->lock);
+}
+
+#endif /* IELR_THREADS */
+
+/**
+ * \pre
+ *   - \c nslots is the number of slots: 1 in the sequential mode, otherwise
+ *     the number of threads, or the maximum number of transitions of a
+ *     state if it is smaller.
+ *   - \c nthreads is the number of workers to start, in addition to the
+ *     calling thread.
+ */
+static void
+ielr_successors_init (ielr_successors *self,
+                      bitsetv follow_kernel_items, bitsetv always_follows,
+                      AnnotationList **annotation_lists, size_t max_nitems,
+                      int nslots, int nthreads)
+{
+  int i;
+  self->follow_kernel_items = follow_kernel_items;
+  self->always_follows = always_follows;
+  self->annotation_lists = annotation_lists;
+  self->s = NULL;
+  self->lookahead_filters = xnmalloc (nslots, sizeof *self->lookahead_filters);
+  self->lookaheads = xnmalloc (nslots, sizeof *self->lookaheads);
+  for (i = 0; i < nslots; ++i)
+    {
+      self->lookahead_filters[i] =
+        bitsetv_create (max_nitems, ntokens, BITSET_FIXED);
+      self->lookaheads[i] = bitsetv_create (max_nitems, ntokens, BITSET_FIXED);
+    }
+  self->nslots = nslots;
+#if IELR_THREADS
+  pthread_mutex_init (&self->lock, NULL);
+  pthread_cond_init (&self->work, NULL);
+  pthread_cond_init (&self->finished, NULL);
+  self->first = self->num = self->next = self->done = 0;
+  self->quit = false;
+  self->threads = xnmalloc (nthreads, sizeof *self->threads);
+  self->nthreads = 0;
+  for (i = 0; i < nthreads; ++i)
+    if (pthread_create (&self->threads[self->nthreads], NULL,
+                        ielr_successors_worker, self) == 0)
+      ++self->nthreads;
+#else
+  (void) nthreads;
+#endif
+}
+
+/** Stop the workers, and release \c self.  */
+static void
+ielr_successors_free (ielr_successors *self)
+{
+  int i;
+#if IELR_THREADS
+  pthread_mutex_lock (&self->lock);
+  self->quit = true;
+  pthread_cond_broadcast (&self->work);
+  pthread_mutex_unlock (&self->lock);
+  for (i = 0; i < self->nthreads; ++i)
+    pthread_join (self->threads[i], NULL);
+  free (self->threads);
+  pthread_cond_destroy (&self->finished);
+  pthread_cond_destroy (&self->work);
+  pthread_mutex_destroy (&self->lock);
+#endif
+  for (i = 0; i < self->nslots; ++i)
+    {
+      bitsetv_free (self->lookahead_filters[i]);
+      bitsetv_free (self->lookaheads[i]);
+    }
+  free (self->lookahead_filters);
+  free (self->lookaheads);
+}
+
 /**
  * \pre
  *   - \c follow_kernel_items and \c always_follows were computed by
@@ -963,12 +1295,14 @@ ielr_split_states (bitsetv follow_kernel_items, bitsetv always_follows,
 {
   state_list *first_state;
   state_list *last_state;
-  bitsetv lookahead_filter = NULL;
-  bitsetv lookaheads;
+  ielr_successors successors;
+  /* Whether the successors of a state are computed in parallel.  */
+  bool parallel = false;
 
   /* Set up state list and some reusable bitsets.  */
   {
     size_t max_nitems = 0;
+    int max_transitions = 1;
     state_number i;
     state_list **nodep = &first_state;
     for (i = 0; i < nstates; ++i)
@@ -979,15 +1313,24 @@ ielr_split_states (bitsetv follow_kernel_items, bitsetv always_follows,
         (*nodep)->lookaheads = NULL;
         (*nodep)->lr0Isocore = *nodep;
         (*nodep)->nextIsocore = *nodep;
+        (*nodep)->lookaheadsChanges = 0;
         nodep = &(*nodep)->next;
         if (states[i]->nitems > max_nitems)
           max_nitems = states[i]->nitems;
+        if (states[i]->transitions->num > max_transitions)
+          max_transitions = states[i]->transitions->num;
       }
     *nodep = NULL;
-    lookahead_filter = bitsetv_create (max_nitems, ntokens, BITSET_FIXED);
-    if (!annotation_lists)
-      bitsetv_ones (lookahead_filter);
-    lookaheads = bitsetv_create (max_nitems, ntokens, BITSET_FIXED);
+    /* The bitset statistics are not thread safe.  */
+    parallel = (IELR_THREADS && 1 < max_threads
+                && !(trace_flag & trace_bitsets));
+    ielr_successors_init (&successors, follow_kernel_items, always_follows,
+                          annotation_lists, max_nitems,
+                          (!parallel ? 1
+                           : max_transitions < max_threads ? max_transitions
+                           : max_threads),
+                          parallel ? max_threads - 1 : 0);
+    lookaheads_table_new ();
   }
 
   /* Recompute states.  */
@@ -997,28 +1340,40 @@ ielr_split_states (bitsetv follow_kernel_items, bitsetv always_follows,
     for (this_state = first_state; this_state; this_state = this_state->next)
       {
         state *s = this_state->state;
+        unsigned int changes = this_state->lookaheadsChanges;
         int i;
+        /* The isocores are chosen in the order of the transitions, as
+           in the sequential mode, so that the states are the same and
+           numbered the same way.  In the parallel mode, the lookaheads
+           are computed for as many transitions as there are slots at a
+           time, and are outdated if merging some of them propagated new
+           lookaheads back to THIS_STATE.  */
         for (i = 0; i < s->transitions->num; ++i)
           {
-            state *t = s->transitions->states[i];
-            if (annotation_lists)
-              AnnotationList__computeLookaheadFilter (
-                annotation_lists[t->state_list->lr0Isocore->state->number],
-                t->nitems, lookahead_filter);
-            ielr_compute_lookaheads (follow_kernel_items, always_follows,
-                                     this_state, t, lookahead_filter,
-                                     lookaheads);
+            int slot = parallel ? i % successors.nslots : 0;
+#if IELR_THREADS
+            if (parallel && slot == 0)
+              {
+                changes = this_state->lookaheadsChanges;
+                ielr_successors_compute_all (&successors, this_state, i);
+              }
+#endif
+            if (!parallel || this_state->lookaheadsChanges != changes)
+              {
+                successors.s = this_state;
+                ielr_successors_compute (&successors, i, slot);
+              }
             ielr_compute_state (follow_kernel_items, always_follows,
-                                annotation_lists, t, lookaheads, &last_state,
-                                work, lookahead_filter,
+                                annotation_lists, s->transitions->states[i],
+                                successors.lookaheads[slot], &last_state,
+                                work, successors.lookahead_filters[slot],
                                 &s->transitions->states[i]);
           }
       }
     free (work);
   }
 
-  bitsetv_free (lookahead_filter);
-  bitsetv_free (lookaheads);
+  ielr_successors_free (&successors);
 
   /* Store states back in the states array.  */
   states = xnrealloc (states, nstates, sizeof *states);
@@ -1070,6 +1425,27 @@ ielr_split_states (bitsetv follow_kernel_items, bitsetv always_follows,
       timevar_pop (TV_IELR_PHASE4);
     }
 
+  if (trace_flag & trace_bitsets)
+    {
+      size_t nitems = 0;
+      state_list *node;
+      for (node = first_state; node; node = node->next)
+        if (node->lookaheads)
+          {
+            size_t i;
+            for (i = 0; i < node->state->nitems; ++i)
+              nitems += !!node->lookaheads[i];
+          }
+      fprintf (stderr,
+               "ielr: %lu item lookahead sets, %lu distinct"
+               " (dedup ratio: %.2f)\n",
+               (unsigned long) nitems,
+               (unsigned long) hash_get_n_entries (lookaheads_table),
+               (double) nitems
+               / (hash_get_n_entries (lookaheads_table)
+                  ? hash_get_n_entries (lookaheads_table) : 1));
+    }
+
   /* Free state list.  */
   while (first_state)
     {
@@ -1079,12 +1455,13 @@ ielr_split_states (bitsetv follow_kernel_items, bitsetv always_follows,
           size_t i;
           for (i = 0; i < node->state->nitems; ++i)
             if (node->lookaheads[i])
-              bitset_free (node->lookaheads[i]);
+              lookaheads_release (node->lookaheads[i]);
           free (node->lookaheads);
         }
       first_state = node->next;
       free (node);
     }
+  lookaheads_table_free ();
 }
 
 void
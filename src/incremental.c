@@ -0,0 +1,325 @@
+/* Reuse of the automaton of a previous run for Bison.
+
+   Copyright (C) 2013 Free Software Foundation, Inc.
+
+   This file is part of Bison, the GNU Compiler Compiler.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include <config.h>
+#include "system.h"
+
+#include <sha1.h>
+
+#include "complain.h"
+#include "conflicts.h"
+#include "getargs.h"
+#include "gram.h"
+#include "incremental.h"
+#include "muscle-tab.h"
+#include "state.h"
+#include "symtab.h"
+#include "tables.h"
+
+char const *incremental_file = NULL;
+
+/* The header of the incremental file.  It is followed by the
+   fingerprint of the grammar, in hexadecimal, on a line of its own,
+   and by the automaton and the parser tables, in binary: the file is
+   not meant to be shared between machines.  */
+#define INCREMENTAL_MAGIC "bison automaton 1\n"
+
+/* The fingerprint of the current grammar, in hexadecimal.  */
+static char fingerprint[2 * SHA1_DIGEST_SIZE + 1];
+
+
+/*----------------------------------------------------.
+| Computing the fingerprint of the current grammar.   |
+`----------------------------------------------------*/
+
+static void
+hash_int (struct sha1_ctx *ctx, int i)
+{
+  sha1_process_bytes (&i, sizeof i, ctx);
+}
+
+/* Feed the string S, which may be null, to CTX.  */
+static void
+hash_string (struct sha1_ctx *ctx, char const *s)
+{
+  hash_int (ctx, !!s);
+  if (s)
+    sha1_process_bytes (s, strlen (s) + 1, ctx);
+}
+
+/* Feed the number of SYM, which may be null, to CTX.  */
+static void
+hash_symbol (struct sha1_ctx *ctx, symbol const *sym)
+{
+  hash_int (ctx, sym ? sym->number : -1);
+}
+
+/* Compute FINGERPRINT: everything the automaton, the parser tables,
+   and the diagnostics issued while computing them depend upon.  The
+   actions matter only for the bypass of the unit rules, and only by
+   their existence.  */
+static void
+fingerprint_compute (void)
+{
+  struct sha1_ctx ctx;
+  unsigned char digest[SHA1_DIGEST_SIZE];
+  bool bypass = muscle_percent_define_flag_if ("lr.bypass-unit-rules");
+  int i;
+
+  sha1_init_ctx (&ctx);
+  hash_string (&ctx, PACKAGE_STRING);
+
+  /* The options.  */
+  {
+    char *type = muscle_percent_define_get ("lr.type");
+    char *default_reduction =
+      muscle_percent_define_get ("lr.default-reduction");
+    hash_string (&ctx, type);
+    hash_string (&ctx, default_reduction);
+    free (type);
+    free (default_reduction);
+  }
+  hash_int (&ctx,
+            muscle_percent_define_flag_if ("lr.keep-unreachable-state"));
+  hash_int (&ctx, bypass);
+  hash_int (&ctx, nondeterministic_parser);
+  hash_int (&ctx, expected_sr_conflicts);
+  hash_int (&ctx, expected_rr_conflicts);
+  hash_int (&ctx, warnings_enabled ());
+
+  /* The symbols.  */
+  hash_int (&ctx, ntokens);
+  hash_int (&ctx, nsyms);
+  for (i = 0; i < nsyms; ++i)
+    {
+      symbol *sym = symbols[i];
+      hash_int (&ctx, sym->prec);
+      hash_int (&ctx, sym->assoc);
+      if (bypass)
+        {
+          hash_string (&ctx, sym->type_name);
+          hash_string (&ctx, symbol_code_props_get (sym, destructor)->code);
+          hash_string (&ctx, symbol_code_props_get (sym, printer)->code);
+        }
+    }
+
+  /* The rules.  */
+  hash_int (&ctx, nrules);
+  hash_int (&ctx, nritems);
+  sha1_process_bytes (ritem, nritems * sizeof *ritem, &ctx);
+  for (i = 0; i < nrules; ++i)
+    {
+      rule const *r = &rules[i];
+      hash_symbol (&ctx, r->lhs);
+      hash_int (&ctx, r->rhs - ritem);
+      hash_symbol (&ctx, r->prec);
+      hash_symbol (&ctx, r->precsym);
+      if (bypass)
+        {
+          hash_int (&ctx, !!r->action);
+          hash_int (&ctx, r->is_predicate);
+          hash_int (&ctx, r->dprec);
+          hash_int (&ctx, r->merger);
+        }
+    }
+
+  sha1_finish_ctx (&ctx, digest);
+  for (i = 0; i < SHA1_DIGEST_SIZE; ++i)
+    sprintf (fingerprint + 2 * i, "%02x", digest[i]);
+}
+
+
+/*-----------------------------.
+| Reading the incremental file.  |
+`-----------------------------*/
+
+/* Read N elements of SIZE bytes from IN, in a new array.  Clear *OK
+   on failure.  */
+static void *
+array_read (FILE *in, size_t n, size_t size, bool *ok)
+{
+  void *res = xnmalloc (n ? n : 1, size);
+  if (*ok && fread (res, size, n, in) != n)
+    *ok = false;
+  return res;
+}
+
+/* Read the automaton and the parser tables from IN, whose header was
+   already read.  */
+static bool
+automaton_read (FILE *in)
+{
+  bool ok = true;
+  int header[7];
+  state_number final;
+  symbol_number *accessing_symbols;
+  state_number s;
+
+  if (fread (header, sizeof *header, 7, in) != 7)
+    return false;
+  final = header[1];
+  if (header[0] <= final || final < 0 || header[2] != header[0] + nvars
+      || header[3] < 0 || header[6] < 1)
+    return false;
+
+  accessing_symbols =
+    array_read (in, header[0], sizeof *accessing_symbols, &ok);
+  nvectors = header[2];
+  high = header[3];
+  base_ninf = header[4];
+  table_ninf = header[5];
+  conflict_list_cnt = header[6];
+  yydefact = array_read (in, header[0], sizeof *yydefact, &ok);
+  yydefgoto = array_read (in, nvars, sizeof *yydefgoto, &ok);
+  base = array_read (in, nvectors, sizeof *base, &ok);
+  table = array_read (in, high + 1, sizeof *table, &ok);
+  check = array_read (in, high + 1, sizeof *check, &ok);
+  conflict_table = array_read (in, high + 1, sizeof *conflict_table, &ok);
+  conflict_list =
+    array_read (in, conflict_list_cnt, sizeof *conflict_list, &ok);
+  ok = ok && getc (in) == EOF;
+
+  /* The states, with only their accessing symbol.  */
+  if (ok)
+    {
+      states = xnmalloc (header[0], sizeof *states);
+      for (s = 0; s < header[0]; ++s)
+        {
+          state *res = xmalloc (offsetof (state, items));
+          res->number = s;
+          res->accessing_symbol = accessing_symbols[s];
+          res->transitions = NULL;
+          res->reductions = NULL;
+          res->errs = NULL;
+          res->state_list = NULL;
+          res->consistent = 0;
+          res->solved_conflicts = NULL;
+          res->solved_conflicts_xml = NULL;
+          res->nitems = 0;
+          states[s] = res;
+        }
+      nstates = header[0];
+      final_state = states[final];
+    }
+  else
+    tables_free ();
+  free (accessing_symbols);
+  return ok;
+}
+
+bool
+incremental_fetch (void)
+{
+  bool res = false;
+  FILE *in;
+
+  fingerprint_compute ();
+  in = fopen (incremental_file, "rb");
+  if (in)
+    {
+      char magic[sizeof INCREMENTAL_MAGIC - 1];
+      char key[sizeof fingerprint + 1];
+      res = (fread (magic, 1, sizeof magic, in) == sizeof magic
+             && !memcmp (magic, INCREMENTAL_MAGIC, sizeof magic)
+             && fread (key, 1, sizeof key, in) == sizeof key
+             && !memcmp (key, fingerprint, sizeof fingerprint - 1)
+             && key[sizeof key - 1] == '\n'
+             && automaton_read (in));
+      fclose (in);
+    }
+  if (trace_flag & trace_incremental)
+    fprintf (stderr, "incremental %s: %s\n", res ? "hit" : "miss",
+             incremental_file);
+  return res;
+}
+
+
+/*-----------------------------.
+| Writing the incremental file.  |
+`-----------------------------*/
+
+/* Write the automaton and the parser tables to OUT.  */
+static void
+automaton_write (FILE *out)
+{
+  symbol_number *accessing_symbols =
+    xnmalloc (nstates, sizeof *accessing_symbols);
+  int header[7];
+  state_number s;
+
+  header[0] = nstates;
+  header[1] = final_state->number;
+  header[2] = nvectors;
+  header[3] = high;
+  header[4] = base_ninf;
+  header[5] = table_ninf;
+  header[6] = conflict_list_cnt;
+  for (s = 0; s < nstates; ++s)
+    accessing_symbols[s] = states[s]->accessing_symbol;
+
+  fwrite (header, sizeof *header, 7, out);
+  fwrite (accessing_symbols, sizeof *accessing_symbols, nstates, out);
+  fwrite (yydefact, sizeof *yydefact, nstates, out);
+  fwrite (yydefgoto, sizeof *yydefgoto, nvars, out);
+  fwrite (base, sizeof *base, nvectors, out);
+  fwrite (table, sizeof *table, high + 1, out);
+  fwrite (check, sizeof *check, high + 1, out);
+  fwrite (conflict_table, sizeof *conflict_table, high + 1, out);
+  fwrite (conflict_list, sizeof *conflict_list, conflict_list_cnt, out);
+  free (accessing_symbols);
+}
+
+void
+incremental_store (void)
+{
+  size_t len = strlen (incremental_file);
+  char *tmp = xmalloc (len + sizeof ".XXXXXX");
+  bool ok;
+  int fd;
+  FILE *out;
+
+  fingerprint_compute ();
+  memcpy (tmp, incremental_file, len);
+  memcpy (tmp + len, ".XXXXXX", sizeof ".XXXXXX");
+
+  /* Failing to write the file is not an error: the next run will
+     compute the automaton.  */
+  fd = mkstemp (tmp);
+  out = fd < 0 ? NULL : fdopen (fd, "wb");
+  if (!out && 0 <= fd)
+    close (fd);
+  ok = !!out;
+  if (ok)
+    {
+      fputs (INCREMENTAL_MAGIC, out);
+      fprintf (out, "%s\n", fingerprint);
+      automaton_write (out);
+      ok &= !ferror (out);
+      ok &= fclose (out) == 0;
+      /* Concurrent runs never read incomplete files.  */
+      ok = ok && rename (tmp, incremental_file) == 0;
+      if (!ok)
+        unlink (tmp);
+    }
+
+  if (trace_flag & trace_incremental)
+    fprintf (stderr, "incremental %s: %s\n",
+             ok ? "store" : "store failure", incremental_file);
+  free (tmp);
+}
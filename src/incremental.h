@@ -0,0 +1,49 @@
+/* Reuse of the automaton of a previous run for Bison.
+
+   Copyright (C) 2013 Free Software Foundation, Inc.
+
+   This file is part of Bison, the GNU Compiler Compiler.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#ifndef INCREMENTAL_H_
+# define INCREMENTAL_H_
+
+/* The incremental file stores the automaton and the parser tables of
+   a grammar, keyed on a fingerprint of everything they depend upon:
+   the symbols, the rules and the precedence, but not the contents of
+   the actions, and the %define lr.* variables.  When only the actions
+   were changed since it was written, the automaton is read from it
+   instead of being computed.  */
+
+/** The incremental file (--incremental), or NULL if disabled.  */
+extern char const *incremental_file;
+
+/** Compute the fingerprint of the current grammar, and if the
+ *  incremental file was written for the same fingerprint, read the
+ *  automaton and the parser tables from it.
+ *
+ *  Must be called after the grammar was reduced.  Only the
+ *  accessing symbols of the states are restored, which is all the
+ *  output needs: the reports need the whole automaton.
+ *
+ *  \return whether the automaton and the parser tables were read.
+ */
+bool incremental_fetch (void);
+
+/** Write the automaton and the parser tables of the current grammar
+ *  to the incremental file.  */
+void incremental_store (void);
+
+#endif /* !INCREMENTAL_H_ */
@@ -494,7 +494,10 @@ void
 lalr_free (void)
 {
   state_number s;
+  if (!LA)
+    return;
   for (s = 0; s < nstates; ++s)
     states[s]->reductions->lookahead_tokens = NULL;
   bitsetv_free (LA);
+  LA = NULL;
 }
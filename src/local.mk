@@ -20,7 +20,20 @@ bin_PROGRAMS = src/bison
 src_bison_SHORTNAME = bison
 
 src_bison_CFLAGS = $(AM_CFLAGS) $(WERROR_CFLAGS)
-src_bison_SOURCES =                             \
+src_bison_SOURCES = src/main.c
+src_bison_LDADD = src/libbison-api.a $(LDADD)
+
+## --------- ##
+## Library.  ##
+## --------- ##
+
+# Everything but the command line interface, see src/bison-api.h.
+# It is not installed: link it with lib/libbison.a.
+noinst_LIBRARIES += src/libbison-api.a
+src_libbison_api_a_SHORTNAME = bison
+
+src_libbison_api_a_CFLAGS = $(AM_CFLAGS) $(WERROR_CFLAGS)
+src_libbison_api_a_SOURCES =                    \
   src/AnnotationList.c                          \
   src/AnnotationList.h                          \
   src/InadequacyList.c                          \
@@ -31,8 +44,14 @@ src_bison_SOURCES =                             \
   src/Sbitset.h                                 \
   src/assoc.c                                   \
   src/assoc.h                                   \
+  src/bison-api.c                               \
+  src/bison-api.h                               \
+  src/cache.c                                   \
+  src/cache.h                                   \
   src/closure.c                                 \
   src/closure.h                                 \
+  src/compile.c                                 \
+  src/compile.h                                 \
   src/complain.c                                \
   src/complain.h                                \
   src/conflicts.c                               \
@@ -52,9 +71,10 @@ src_bison_SOURCES =                             \
   src/lalr.h                                    \
   src/ielr.c                                    \
   src/ielr.h                                    \
+  src/incremental.c                             \
+  src/incremental.h                             \
   src/location.c                                \
   src/location.h                                \
-  src/main.c                                    \
   src/muscle-tab.c                              \
   src/muscle-tab.h                              \
   src/named-ref.c                               \
@@ -94,7 +114,7 @@ src_bison_SOURCES =                             \
   src/uniqstr.c                                 \
   src/uniqstr.h
 
-EXTRA_src_bison_SOURCES =                       \
+EXTRA_src_libbison_api_a_SOURCES =              \
   src/scan-code.l                               \
   src/scan-gram.l                               \
   src/scan-skel.l
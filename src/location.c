@@ -22,6 +22,7 @@
 
 #include <mbswidth.h>
 #include <quotearg.h>
+#include <read-file.h>
 
 #include "complain.h"
 #include "location.h"
@@ -137,82 +138,106 @@ location_print (location loc, FILE *out)
 }
 
 
-/* Persistant data used by location_caret to avoid reopening and rereading the
-   same file all over for each error.  */
-struct caret_info
+/* The files quoted by location_caret.  Each is read once, and the
+   beginnings of its lines are indexed, so that quoting any line costs
+   only its length, whatever the order of the locations.  */
+typedef struct caret_file
 {
-  FILE *source;
-  size_t line;
-  size_t offset;
-};
-
-static struct caret_info caret_info = { NULL, 1, 0 };
+  /* The name of the file, as in the locations.  */
+  uniqstr name;
+  /* Its contents, or NULL if it could not be read.  */
+  char *contents;
+  size_t size;
+  /* LINES[L - 1] is the offset of the beginning of line L, for each of
+     the NLINES lines.  */
+  size_t *lines;
+  size_t nlines;
+  struct caret_file *next;
+} caret_file;
+
+static caret_file *caret_files = NULL;
 
 void
 cleanup_caret ()
 {
-  if (caret_info.source)
-    fclose (caret_info.source);
-  caret_info.source = NULL;
-  caret_info.line = 1;
-  caret_info.offset = 0;
+  while (caret_files)
+    {
+      caret_file *next = caret_files->next;
+      free (caret_files->contents);
+      free (caret_files->lines);
+      free (caret_files);
+      caret_files = next;
+    }
+}
+
+/* The file NAME, read and indexed if not already done.  */
+static caret_file *
+caret_file_get (uniqstr name)
+{
+  caret_file *res;
+  for (res = caret_files; res; res = res->next)
+    if (UNIQSTR_EQ (res->name, name))
+      return res;
+
+  res = xmalloc (sizeof *res);
+  res->name = name;
+  res->contents = read_file (name, &res->size);
+  res->lines = NULL;
+  res->nlines = 0;
+  if (res->contents)
+    {
+      char const *p = res->contents;
+      char const *end = res->contents + res->size;
+      size_t alloc = 0;
+      while (p < end)
+        {
+          char const *eol = memchr (p, '\n', end - p);
+          if (res->nlines == alloc)
+            res->lines = x2nrealloc (res->lines, &alloc, sizeof *res->lines);
+          res->lines[res->nlines++] = p - res->contents;
+          p = eol ? eol + 1 : end;
+        }
+    }
+  res->next = caret_files;
+  caret_files = res;
+  return res;
 }
 
 void
 location_caret (location loc, FILE *out)
 {
-  /* FIXME: find a way to support multifile locations, and only open once each
-     file. That would make the procedure future-proof.  */
-  if (! (caret_info.source
-         || (caret_info.source = fopen (loc.start.file, "r")))
-      || loc.start.column == -1 || loc.start.line == -1)
+  caret_file *file;
+  size_t lineno = loc.start.line;
+  char const *line;
+  size_t len;
+
+  if (!loc.start.file || loc.start.column == -1 || loc.start.line < 1)
+    return;
+  file = caret_file_get (loc.start.file);
+  if (file->nlines < lineno)
     return;
 
-  /* If the line we want to quote is seekable (the same line as the previous
-     location), just seek it. If it was a previous line, we lost track of it,
-     so return to the start of file.  */
-  if (caret_info.line <= loc.start.line)
-    fseek (caret_info.source, caret_info.offset, SEEK_SET);
-  else
-    {
-      caret_info.line = 1;
-      caret_info.offset = 0;
-      fseek (caret_info.source, caret_info.offset, SEEK_SET);
-    }
+  /* The line, with its end of line if any.  */
+  line = file->contents + file->lines[lineno - 1];
+  len = ((lineno < file->nlines ? file->lines[lineno] : file->size)
+         - file->lines[lineno - 1]);
 
-  /* Advance to the line's position, keeping track of the offset.  */
-  while (caret_info.line < loc.start.line)
-    caret_info.line += getc (caret_info.source) == '\n';
-  caret_info.offset = ftell (caret_info.source);
+  /* Quote the line, indent by a single column.  */
+  putc (' ', out);
+  fwrite (line, 1, line[len - 1] == '\n' ? len - 1 : len, out);
+  putc ('\n', out);
 
-  /* Read the actual line.  Don't update the offset, so that we keep a pointer
-     to the start of the line.  */
   {
-    char c = getc (caret_info.source);
-    if (c != EOF)
-      {
-        /* Quote the file, indent by a single column.  */
-        putc (' ', out);
-        do
-          putc (c, out);
-        while ((c = getc (caret_info.source)) != EOF && c != '\n');
-        putc ('\n', out);
-
-        {
-          /* The caret of a multiline location ends with the first line.  */
-          size_t len = loc.start.line != loc.end.line
-            ? ftell (caret_info.source) - caret_info.offset
-            : loc.end.column;
-          int i;
-
-          /* Print the carets (at least one), with the same indent as above.*/
-          fprintf (out, " %*s", loc.start.column - 1, "");
-          for (i = loc.start.column; i == loc.start.column || i < len; ++i)
-            putc ('^', out);
-          }
-        putc ('\n', out);
-      }
+    /* The caret of a multiline location ends with the first line.  */
+    int end = loc.start.line != loc.end.line ? len : loc.end.column;
+    int i;
+
+    /* Print the carets (at least one), with the same indent as above.*/
+    fprintf (out, " %*s", loc.start.column - 1, "");
+    for (i = loc.start.column; i == loc.start.column || i < end; ++i)
+      putc ('^', out);
   }
+  putc ('\n', out);
 }
 
 void
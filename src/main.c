@@ -24,128 +24,95 @@
 #include <bitset_stats.h>
 #include <bitset.h>
 #include <configmake.h>
+#include <errno.h>
 #include <progname.h>
 #include <quotearg.h>
 #include <timevar.h>
 
-#include "LR0.h"
+#include "cache.h"
 #include "closeout.h"
+#include "compile.h"
 #include "complain.h"
-#include "conflicts.h"
-#include "derives.h"
 #include "files.h"
 #include "getargs.h"
-#include "gram.h"
+#include "incremental.h"
 #include "lalr.h"
-#include "ielr.h"
 #include "muscle-tab.h"
-#include "nullable.h"
 #include "output.h"
 #include "print.h"
 #include "print_graph.h"
 #include "print-xml.h"
 #include <quote.h>
 #include "reader.h"
-#include "reduce.h"
-#include "scan-code.h"
-#include "scan-gram.h"
-#include "scan-skel.h"
-#include "symtab.h"
-#include "tables.h"
 #include "uniqstr.h"
 
-
-int
-main (int argc, char *argv[])
+#if HAVE_FORK && HAVE_SYS_WAIT_H
+# include <sys/wait.h>
+# define JOBS_PARALLEL 1
+#else
+# define JOBS_PARALLEL 0
+#endif
+
+/*---------------------------------------------------------------.
+| Process GRAMMAR_FILE: read it, build the automaton, and output |
+| the reports and the parser.  OPTIONS, of size NOPTIONS, are    |
+| the command line options, for the cache.                       |
+`---------------------------------------------------------------*/
+
+static void
+process_grammar (char *options[], int noptions)
 {
-  set_program_name (argv[0]);
-  setlocale (LC_ALL, "");
-  (void) bindtextdomain (PACKAGE, LOCALEDIR);
-  (void) bindtextdomain ("bison-runtime", LOCALEDIR);
-  (void) textdomain (PACKAGE);
-
-  {
-    char const *cp = getenv ("LC_CTYPE");
-    if (cp && STREQ (cp, "C"))
-      set_custom_quoting (&quote_quoting_options, "'", "'");
-    else
-      set_quoting_style (&quote_quoting_options, locale_quoting_style);
-  }
-
-  atexit (close_stdout);
-
-  uniqstrs_new ();
-  muscle_init ();
-  complain_init ();
-
-  getargs (argc, argv);
-
-  timevar_report = trace_flag & trace_time;
-  init_timevar ();
-  timevar_start (TV_TOTAL);
-
-  if (trace_flag & trace_bitsets)
-    bitset_stats_enable ();
-
   /* Read the input.  Copy some parts of it to FGUARD, FACTION, FTABLE
      and FATTRS.  In file reader.c.  The other parts are recorded in
      the grammar; see gram.h.  */
 
   timevar_push (TV_READER);
-  reader ();
+  reader (NULL, 0);
   timevar_pop (TV_READER);
 
   if (complaint_status == status_complaint)
-    goto finish;
-
-  /* Find useless nonterminals and productions and reduce the grammar. */
-  timevar_push (TV_REDUCE);
-  reduce_grammar ();
-  timevar_pop (TV_REDUCE);
-
-  /* Record other info about the grammar.  In files derives and
-     nullable.  */
-  timevar_push (TV_SETS);
-  derives_compute ();
-  nullable_compute ();
-  timevar_pop (TV_SETS);
-
-  /* Compute LR(0) parser states.  See state.h for more info.  */
-  timevar_push (TV_LR0);
-  generate_states ();
-  timevar_pop (TV_LR0);
-
-  /* Add lookahead sets to parser states.  Except when LALR(1) is
-     requested, split states to eliminate LR(1)-relative
-     inadequacies.  */
-  ielr ();
-
-  /* Find and record any conflicts: places where one token of
-     lookahead is not enough to disambiguate the parsing.  In file
-     conflicts.  Also resolve s/r conflicts based on precedence
-     declarations.  */
-  timevar_push (TV_CONFLICTS);
-  conflicts_solve ();
-  if (!muscle_percent_define_flag_if ("lr.keep-unreachable-state"))
+    return;
+
+  /* If this grammar was already processed, reuse the output files.  */
+  if (cache_dir)
     {
-      state_number *old_to_new = xnmalloc (nstates, sizeof *old_to_new);
-      state_number nstates_old = nstates;
-      state_remove_unreachable_states (old_to_new);
-      lalr_update_state_numbers (old_to_new, nstates_old);
-      conflicts_update_state_numbers (old_to_new, nstates_old);
-      free (old_to_new);
+      bool hit;
+      timevar_push (TV_CACHE);
+      hit = cache_fetch (options, noptions);
+      timevar_pop (TV_CACHE);
+      if (hit)
+        return;
     }
-  conflicts_print ();
-  timevar_pop (TV_CONFLICTS);
 
-  /* Compute the parser tables.  */
-  timevar_push (TV_ACTIONS);
-  tables_generate ();
-  timevar_pop (TV_ACTIONS);
-
-  grammar_rules_useless_report (_("rule useless in parser due to conflicts"));
-
-  print_precedence_warnings ();
+  /* Build the automaton and the parser tables, unless only the
+     actions changed since the incremental file was written.  The
+     reports need the whole automaton, which is not saved.  */
+  compile_grammar ();
+  {
+    bool hit = false;
+    if (incremental_file && !report_flag && !graph_flag && !xml_flag)
+      {
+        timevar_push (TV_INCREMENTAL);
+        hit = incremental_fetch ();
+        timevar_pop (TV_INCREMENTAL);
+      }
+    if (!hit)
+      {
+        bool issued = complaint_issued;
+        complaint_issued = false;
+        compile_tables ();
+        /* Don't save the automaton if computing it issued
+           diagnostics, since they would not be repeated when reusing
+           it.  */
+        if (incremental_file && !complaint_issued)
+          {
+            timevar_push (TV_INCREMENTAL);
+            incremental_store ();
+            timevar_pop (TV_INCREMENTAL);
+          }
+        complaint_issued |= issued;
+      }
+  }
 
   /* Output file names. */
   compute_output_file_names ();
@@ -177,7 +144,7 @@ main (int argc, char *argv[])
   /* Stop if there were errors, to avoid trashing previous output
      files.  */
   if (complaint_status == status_complaint)
-    goto finish;
+    return;
 
   /* Lookahead tokens are no longer needed. */
   timevar_push (TV_FREE);
@@ -189,36 +156,198 @@ main (int argc, char *argv[])
   output ();
   timevar_pop (TV_PARSER);
 
-  timevar_push (TV_FREE);
-  nullable_free ();
-  derives_free ();
-  tables_free ();
-  states_free ();
-  reduce_free ();
-  conflicts_free ();
-  grammar_free ();
-  output_file_names_free ();
-
-  /* The scanner memory cannot be released right after parsing, as it
-     contains things such as user actions, prologue, epilogue etc.  */
-  gram_scanner_free ();
-  muscle_free ();
+  /* Don't cache the output files if there were diagnostics, since
+     they would not be repeated when reusing them.  */
+  if (cache_dir && !complaint_issued)
+    {
+      timevar_push (TV_CACHE);
+      cache_store ();
+      timevar_pop (TV_CACHE);
+    }
+}
+
+
+#if JOBS_PARALLEL
+
+/* Number of child processes processing a grammar file.  */
+static int running_jobs = 0;
+
+/*--------------------------------------------------------------.
+| Wait for one of the child processes to finish, and return its |
+| exit status.                                                  |
+`--------------------------------------------------------------*/
+
+static int
+job_wait (void)
+{
+  int wstatus;
+  pid_t pid;
+  do
+    pid = wait (&wstatus);
+  while (pid < 0 && errno == EINTR);
+  if (pid < 0)
+    {
+      running_jobs = 0;
+      return EXIT_FAILURE;
+    }
+  --running_jobs;
+  return (WIFEXITED (wstatus) && WEXITSTATUS (wstatus) == EXIT_SUCCESS
+          ? EXIT_SUCCESS
+          : EXIT_FAILURE);
+}
+
+/*---------------------------------------------------------------.
+| The options OPTIONS, of size NOPTIONS, without -j/--jobs, in a |
+| new array of size *NRES.                                       |
+`---------------------------------------------------------------*/
+
+static char **
+job_options (char *options[], int noptions, int *nres)
+{
+  char **res = xnmalloc (noptions + 1, sizeof *res);
+  int i;
+  *nres = 0;
+  for (i = 0; i < noptions; ++i)
+    {
+      bool separate;
+      if (jobs_option_p (options[i], &separate))
+        i += separate;
+      else
+        res[(*nres)++] = options[i];
+    }
+  return res;
+}
+
+/*-----------------------------------------------------------------.
+| Process GRAMMAR_FILE in a child process, once less than MAX_JOBS |
+| are running.  OPTIONS and NOPTIONS are as for process_grammar.   |
+| Return false if the child process could not be created, and set  |
+| *EXIT_STATUS to EXIT_FAILURE if a previous child process failed. |
+`-----------------------------------------------------------------*/
+
+static bool
+job_spawn (char *options[], int noptions, int *exit_status)
+{
+  pid_t pid;
+  if (running_jobs == max_jobs && job_wait () != EXIT_SUCCESS)
+    *exit_status = EXIT_FAILURE;
+
+  /* Don't have the child flush our buffers too.  */
+  fflush (stdout);
+  fflush (stderr);
+  pid = fork ();
+  if (pid < 0)
+    return false;
+  if (pid == 0)
+    {
+      /* The child processes the grammar as a run without -j would,
+         and in particular uses the same cache entry.  */
+      int nchild_options;
+      char **child_options = job_options (options, noptions,
+                                          &nchild_options);
+      /* The CPU times of the child start afresh.  */
+      init_timevar ();
+      timevar_start (TV_TOTAL);
+      process_grammar (child_options, nchild_options);
+      free (child_options);
+      if (cache_dir && trace_flag & trace_cache)
+        cache_print_stats (stderr);
+      timevar_stop (TV_TOTAL);
+      timevar_print (stderr);
+      exit (complaint_status ? EXIT_FAILURE : EXIT_SUCCESS);
+    }
+  ++running_jobs;
+  return true;
+}
+
+#endif /* JOBS_PARALLEL */
+
+
+int
+main (int argc, char *argv[])
+{
+  int exit_status = EXIT_SUCCESS;
+  int njobs;
+  int noptions;
+  int job = 0;
+  /* The traces of all the grammars: trace_flag is reset for each.  */
+  int traces = trace_none;
+
+  set_program_name (argv[0]);
+  setlocale (LC_ALL, "");
+  (void) bindtextdomain (PACKAGE, LOCALEDIR);
+  (void) bindtextdomain ("bison-runtime", LOCALEDIR);
+  (void) textdomain (PACKAGE);
+
+  {
+    char const *cp = getenv ("LC_CTYPE");
+    if (cp && STREQ (cp, "C"))
+      set_custom_quoting (&quote_quoting_options, "'", "'");
+    else
+      set_quoting_style (&quote_quoting_options, locale_quoting_style);
+  }
+
+  atexit (close_stdout);
+
+  uniqstrs_new ();
+
+  /* Process the grammar files one after the other, in this process,
+     or, with --jobs, in up to MAX_JOBS child processes at a time.
+     The command line is decoded anew for each of them, since the
+     grammar files may override its settings.  */
+  do
+    {
+      muscle_init ();
+      complain_init ();
+
+      njobs = getargs (argc, argv, job, &noptions);
+      traces |= trace_flag;
+
+      if (job == 0)
+        {
+          timevar_report = trace_flag & trace_time;
+          init_timevar ();
+          timevar_start (TV_TOTAL);
+        }
+
+      if (trace_flag & trace_bitsets)
+        bitset_stats_enable ();
+
+#if JOBS_PARALLEL
+      if (1 < max_jobs && 1 < njobs
+          && job_spawn (argv + 1, noptions, &exit_status))
+        {
+          /* Only the settings were computed for this grammar.  */
+          muscle_free ();
+          continue;
+        }
+#endif
+
+      process_grammar (argv + 1, noptions);
+      if (complaint_status)
+        exit_status = EXIT_FAILURE;
+      compile_release ();
+    }
+  while (++job < njobs);
+
+#if JOBS_PARALLEL
+  while (running_jobs)
+    if (job_wait () != EXIT_SUCCESS)
+      exit_status = EXIT_FAILURE;
+#endif
+
   uniqstrs_free ();
-  code_scanner_free ();
-  skel_scanner_free ();
   quotearg_free ();
-  timevar_pop (TV_FREE);
 
-  if (trace_flag & trace_bitsets)
+  if (traces & trace_bitsets)
     bitset_stats_dump (stderr);
 
- finish:
+  if (cache_dir && traces & trace_cache)
+    cache_print_stats (stderr);
 
   /* Stop timing and print the times.  */
   timevar_stop (TV_TOTAL);
   timevar_print (stderr);
 
-  cleanup_caret ();
-
-  return complaint_status ? EXIT_FAILURE : EXIT_SUCCESS;
+  return exit_status;
 }
@@ -53,13 +53,29 @@ muscle_kind_string (muscle_kind k)
 }
 
 
+/* A piece of the value of a muscle built by muscle_grow.  */
+typedef struct muscle_chunk
+{
+  struct muscle_chunk *next;
+  size_t size;
+  char text[1];
+} muscle_chunk;
+
 /* A key-value pair, along with storage that can be reclaimed when
-   this pair is no longer needed.  */
+   this pair is no longer needed.
+
+   The values built by muscle_grow are lists of chunks (CHUNKS), so
+   that appending does not copy the previous value.  VALUE is then
+   NULL until the value is needed as a single string, in which case
+   the chunks are copied into STORAGE.  */
 typedef struct
 {
   char const *key;
   char const *value;
   char *storage;
+  muscle_chunk *chunks;
+  muscle_chunk **chunks_tail;
+  size_t chunks_size;
   muscle_kind kind;
 } muscle_entry;
 
@@ -106,17 +122,36 @@ muscle_entry_new (char const *key)
   res->key = key;
   res->value = NULL;
   res->storage = NULL;
+  res->chunks = NULL;
+  res->chunks_tail = &res->chunks;
+  res->chunks_size = 0;
   if (!hash_insert (muscle_table, res))
     xalloc_die ();
   return res;
 }
 
+/* Free the value of ENTRY.  */
+static void
+muscle_entry_clear (muscle_entry *entry)
+{
+  while (entry->chunks)
+    {
+      muscle_chunk *next = entry->chunks->next;
+      free (entry->chunks);
+      entry->chunks = next;
+    }
+  entry->chunks_tail = &entry->chunks;
+  entry->chunks_size = 0;
+  free (entry->storage);
+  entry->storage = NULL;
+  entry->value = NULL;
+}
+
 static void
 muscle_entry_free (void *entry)
 {
-  muscle_entry *mentry = entry;
-  free (mentry->storage);
-  free (mentry);
+  muscle_entry_clear (entry);
+  free (entry);
 }
 
 void
@@ -156,19 +191,39 @@ muscle_insert (char const *key, char const *value)
 {
   muscle_entry *entry = muscle_lookup (key);
   if (entry)
-    free (entry->storage);
+    muscle_entry_clear (entry);
   else
     /* First insertion in the hash. */
     entry = muscle_entry_new (key);
   entry->value = value;
-  entry->storage = NULL;
 }
 
 
+/* Append the concatenation of S1, S2 and S3 (of sizes N1, N2 and N3)
+   to the chunks of ENTRY.  */
+
+static void
+muscle_chunk_append (muscle_entry *entry,
+                     char const *s1, size_t n1,
+                     char const *s2, size_t n2,
+                     char const *s3, size_t n3)
+{
+  size_t size = n1 + n2 + n3;
+  muscle_chunk *chunk = xmalloc (offsetof (muscle_chunk, text) + size);
+  memcpy (chunk->text, s1, n1);
+  memcpy (chunk->text + n1, s2, n2);
+  memcpy (chunk->text + n1 + n2, s3, n3);
+  chunk->size = size;
+  chunk->next = NULL;
+  *entry->chunks_tail = chunk;
+  entry->chunks_tail = &chunk->next;
+  entry->chunks_size += size;
+}
+
 /* Append VALUE to the current value of KEY.  If KEY did not already
-   exist, create it.  Use MUSCLE_OBSTACK.  De-allocate the previously
-   associated value.  Copy VALUE and SEPARATOR.  If VALUE does not end
-   with TERMINATOR, append one.  */
+   exist, create it.  Copy VALUE and SEPARATOR.  If VALUE does not end
+   with TERMINATOR, append one.  This runs in time proportional to the
+   size of VALUE, not of the current value of KEY.  */
 
 static void
 muscle_grow (const char *key, const char *val,
@@ -177,27 +232,51 @@ muscle_grow (const char *key, const char *val,
   muscle_entry *entry = muscle_lookup (key);
   size_t vals = strlen (val);
   size_t terms = strlen (terminator);
+  bool terminate = terms <= vals && STRNEQ (val + vals - terms, terminator);
+  size_t seps = 0;
 
-  if (entry)
+  if (!entry)
+    entry = muscle_entry_new (key);
+  else
     {
-      obstack_sgrow (&muscle_obstack, entry->value);
-      obstack_sgrow (&muscle_obstack, separator);
+      /* A value set by muscle_insert becomes the first chunk.  */
+      if (!entry->chunks && entry->value)
+        {
+          char *value = xstrdup (entry->value);
+          muscle_entry_clear (entry);
+          muscle_chunk_append (entry, value, strlen (value), "", 0, "", 0);
+          free (value);
+        }
+      /* The single string, if it was computed, is outdated.  */
       free (entry->storage);
+      entry->storage = NULL;
+      entry->value = NULL;
+      if (entry->chunks)
+        seps = strlen (separator);
     }
-  else
-    entry = muscle_entry_new (key);
 
-  obstack_sgrow (&muscle_obstack, val);
+  muscle_chunk_append (entry, separator, seps, val, vals,
+                       terminator, terminate ? terms : 0);
+}
 
-  if (terms <= vals
-      && STRNEQ (val + vals - terms, terminator))
-    obstack_sgrow (&muscle_obstack, terminator);
+/* Make sure that the value of ENTRY is available as a single string,
+   ENTRY->value.  */
 
-  {
-    char *new_val = obstack_finish0 (&muscle_obstack);
-    entry->value = entry->storage = xstrdup (new_val);
-    obstack_free (&muscle_obstack, new_val);
-  }
+static void
+muscle_entry_flatten (muscle_entry *entry)
+{
+  if (!entry->value && entry->chunks)
+    {
+      char *p = entry->storage = xmalloc (entry->chunks_size + 1);
+      muscle_chunk *c;
+      for (c = entry->chunks; c; c = c->next)
+        {
+          memcpy (p, c->text, c->size);
+          p += c->size;
+        }
+      *p = '\0';
+      entry->value = entry->storage;
+    }
 }
 
 /*------------------------------------------------------------------.
@@ -252,7 +331,10 @@ char const *
 muscle_find_const (char const *key)
 {
   muscle_entry *entry = muscle_lookup (key);
-  return entry ? entry->value : NULL;
+  if (!entry)
+    return NULL;
+  muscle_entry_flatten (entry);
+  return entry->value;
 }
 
 
@@ -262,6 +344,7 @@ muscle_find (char const *key)
   muscle_entry *entry = muscle_lookup (key);
   if (entry)
     {
+      muscle_entry_flatten (entry);
       aver (entry->value == entry->storage);
       return entry->storage;
     }
@@ -751,9 +834,17 @@ muscle_percent_code_grow (char const *qualifier, location qualifier_loc,
 static inline bool
 muscle_m4_output (muscle_entry *entry, FILE *out)
 {
-  fprintf (out,
-           "m4_define([b4_%s],\n"
-           "[[%s]])\n\n\n", entry->key, entry->value);
+  fprintf (out, "m4_define([b4_%s],\n[[", entry->key);
+  /* Stream the chunks rather than gluing them together.  */
+  if (entry->value)
+    fputs (entry->value, out);
+  else
+    {
+      muscle_chunk *c;
+      for (c = entry->chunks; c; c = c->next)
+        fwrite (c->text, 1, c->size, out);
+    }
+  fputs ("]])\n\n\n", out);
   return true;
 }
 
@@ -139,4 +139,5 @@ void
 nullable_free (void)
 {
   free (nullable);
+  nullable = NULL;
 }
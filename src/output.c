@@ -25,6 +25,7 @@
 #include <configmake.h>
 #include <filename.h>
 #include <get-errno.h>
+#include <hash.h>
 #include <quotearg.h>
 #include <spawn-pipe.h>
 #include <timevar.h>
@@ -366,6 +367,129 @@ user_actions_output (FILE *out)
   fputs ("])\n\n", out);
 }
 
+/*--------------------------------------------------------------.
+| For the direct code (%define parse.codegen direct), output to |
+| OUT the contents of yypact, yytable etc. as lists of cases.    |
+`--------------------------------------------------------------*/
+
+/* Whether %define parse.codegen direct was given.  The skeletons
+   check the value of this variable, and report it if unused, so
+   don't register its use.  */
+static bool
+direct_codegen_p (void)
+{
+  char const *value = muscle_find_const ("percent_define(parse.codegen)");
+  return value && STREQ (value, "direct");
+}
+
+/* A case of the direct code: when the switch is on KEY, go to, or
+   reduce with VALUE.  */
+typedef struct
+{
+  int value;
+  int key;
+} direct_case;
+
+static int
+direct_case_cmp (void const *a, void const *b)
+{
+  direct_case const *c1 = a;
+  direct_case const *c2 = b;
+  if (c1->value != c2->value)
+    return (c1->value > c2->value) - (c1->value < c2->value);
+  return (c1->key > c2->key) - (c1->key < c2->key);
+}
+
+/* Output to OUT the N CASES as calls to MACRO (VALUE, KEY...), one
+   per value.  Sorts CASES.  */
+static void
+direct_cases_output (FILE *out, char const *macro,
+                     direct_case *cases, int n)
+{
+  int i;
+  qsort (cases, n, sizeof *cases, direct_case_cmp);
+  for (i = 0; i < n; ++i)
+    {
+      if (!i || cases[i].value != cases[i - 1].value)
+        fprintf (out, "%s%s(%d", i ? ")\n" : "", macro, cases[i].value);
+      fprintf (out, ", %d", cases[i].key);
+    }
+  if (n)
+    fputs (")\n", out);
+}
+
+/* The entries of the vector of TABLE based at BASE_VALUE: the keys
+   K in [0, N) such that CHECK[BASE_VALUE + K] = K, with TABLE values.
+   Return their number.  This is exactly what the table-driven parser
+   looks up, even for BASE_NINF.  */
+static int
+direct_cases_collect (direct_case *cases, base_number base_value, int n)
+{
+  int res = 0;
+  int loc;
+  for (loc = base_value < 0 ? 0 : base_value;
+       loc <= high && loc - base_value < n;
+       ++loc)
+    if (check[loc] == loc - base_value)
+      {
+        cases[res].key = loc - base_value;
+        cases[res].value = table[loc];
+        ++res;
+      }
+  return res;
+}
+
+static void
+direct_code_output (FILE *out)
+{
+  int size = state_number_as_int (nstates) < ntokens
+    ? ntokens : state_number_as_int (nstates);
+  direct_case *cases = xnmalloc (size, sizeof *cases);
+  state_number s;
+  symbol_number i;
+  int n;
+
+  /* The states that do not need a lookahead, by default rule.  */
+  n = 0;
+  for (s = 0; s < nstates; ++s)
+    if (base[s] == base_ninf)
+      {
+        cases[n].key = s;
+        cases[n].value = yydefact[s];
+        ++n;
+      }
+  fputs ("m4_define([b4_direct_defaults],\n[", out);
+  direct_cases_output (out, "b4_direct_default", cases, n);
+  fputs ("])\n\n", out);
+
+  /* The actions of the other states, by value of yytable.  */
+  fputs ("m4_define([b4_direct_actions],\n[", out);
+  for (s = 0; s < nstates; ++s)
+    if (base[s] != base_ninf)
+      {
+        fprintf (out, "b4_direct_state(%d,\n[", s);
+        n = direct_cases_collect (cases, base[s], ntokens);
+        direct_cases_output (out, "b4_direct_action", cases, n);
+        fputs ("])\n", out);
+      }
+  fputs ("])\n\n", out);
+
+  /* The gotos, by destination state.  */
+  fputs ("m4_define([b4_direct_gotos],\n[", out);
+  for (i = ntokens; i < nsyms; ++i)
+    {
+      fprintf (out, "b4_direct_goto(%d, %d,\n[",
+               i, yydefgoto[i - ntokens]);
+      n = direct_cases_collect (cases, base[nstates + i - ntokens], nstates);
+      direct_cases_output (out, "b4_direct_goto_from", cases, n);
+      fputs ("])\n", out);
+    }
+  fputs ("])\n\n", out);
+
+  free (cases);
+}
+
+
 /*------------------------------------.
 | Output the merge functions to OUT.  |
 `------------------------------------*/
@@ -520,6 +644,225 @@ prepare_actions (void)
 }
 
 
+/*----------------------------------------------------------------.
+| For %define parse.error.tables, the tokens reported as expected |
+| in the verbose error messages of each state, and the size of    |
+| the token names in these messages.                              |
+`----------------------------------------------------------------*/
+
+/* Whether %define parse.error.tables was given.  As for
+   parse.codegen, the skeletons report it if unused.  */
+static bool
+error_tables_p (void)
+{
+  char const *value =
+    muscle_find_const ("percent_define(parse.error.tables)");
+  return value && (!*value || STREQ (value, "true"));
+}
+
+/* The maximum number of expected tokens in an error message, as in
+   the skeletons: if there are more, none is reported.  */
+enum { EXPECTED_MAX = 4 };
+
+/* A list of expected tokens, and its index in yyexpected.  */
+typedef struct
+{
+  int count;
+  symbol_number tokens[EXPECTED_MAX];
+  int index;
+} expected_list;
+
+static size_t
+expected_list_hasher (void const *m, size_t tablesize)
+{
+  expected_list const *l = m;
+  size_t res = l->count;
+  int i;
+  for (i = 0; i < l->count; ++i)
+    res = res * 31 + l->tokens[i];
+  return res % tablesize;
+}
+
+static bool
+expected_list_comparator (void const *m1, void const *m2)
+{
+  expected_list const *l1 = m1;
+  expected_list const *l2 = m2;
+  return (l1->count == l2->count
+          && !memcmp (l1->tokens, l2->tokens,
+                      l1->count * sizeof *l1->tokens));
+}
+
+/* Sort the longest lists first, so that the shorter ones are found
+   inside them.  */
+static int
+expected_list_cmp (void const *a, void const *b)
+{
+  expected_list const *l1 = *(expected_list * const *) a;
+  expected_list const *l2 = *(expected_list * const *) b;
+  int i;
+  if (l1->count != l2->count)
+    return l2->count - l1->count;
+  for (i = 0; i < l1->count; ++i)
+    if (l1->tokens[i] != l2->tokens[i])
+      return l1->tokens[i] - l2->tokens[i];
+  return 0;
+}
+
+/* Set L to the tokens expected in state S, as computed by yysyntax_error
+   from yypact, yycheck and yytable.  */
+static void
+expected_list_compute (state_number s, expected_list *l)
+{
+  base_number n = base[s];
+  l->count = 0;
+  l->index = 0;
+  if (n != base_ninf)
+    {
+      int x;
+      int xend = high - n + 1 < ntokens ? high - n + 1 : ntokens;
+      for (x = n < 0 ? -n : 0; x < xend; ++x)
+        if (check[x + n] == x && x != errtoken->number
+            && table[x + n] != table_ninf)
+          {
+            if (l->count == EXPECTED_MAX)
+              {
+                l->count = 0;
+                break;
+              }
+            l->tokens[l->count++] = x;
+          }
+    }
+}
+
+/* Register in WINDOWS the sublists of EXPECTED[0 .. N-1] that end at
+   its last element.  */
+static void
+expected_windows_add (Hash_table *windows, int const *expected, int n)
+{
+  int count;
+  for (count = 1; count <= EXPECTED_MAX && count <= n; ++count)
+    {
+      expected_list *w = xmalloc (sizeof *w);
+      expected_list *res;
+      int i;
+      w->count = count;
+      w->index = n - count;
+      for (i = 0; i < count; ++i)
+        w->tokens[i] = expected[n - count + i];
+      res = hash_insert (windows, w);
+      if (!res)
+        xalloc_die ();
+      if (res != w)
+        free (w);
+    }
+}
+
+/* The size of the name of the symbol whose tag is TAG in the error
+   messages, as computed by yytnamerr.  */
+static int
+tnamerr_size (char const *tag)
+{
+  if (*tag == '"')
+    {
+      int res = 0;
+      char const *cp = tag;
+      for (;;)
+        switch (*++cp)
+          {
+          case '\'':
+          case ',':
+            goto do_not_strip_quotes;
+
+          case '\\':
+            if (*++cp != '\\')
+              goto do_not_strip_quotes;
+            /* Fall through.  */
+          default:
+            ++res;
+            break;
+
+          case '"':
+            return res;
+          }
+    do_not_strip_quotes: ;
+    }
+  return strlen (tag);
+}
+
+static void
+prepare_error_tables (void)
+{
+  expected_list *lists = xnmalloc (nstates, sizeof *lists);
+  expected_list **sorted = xnmalloc (nstates, sizeof *sorted);
+  /* The lists of all the states, stored once, and possibly
+     overlapping.  */
+  int *expected = xnmalloc (nstates * EXPECTED_MAX + 1, sizeof *expected);
+  int nexpected = 0;
+  /* The sublists of EXPECTED, to find the lists already stored.  */
+  Hash_table *windows =
+    hash_initialize (nstates, NULL, expected_list_hasher,
+                     expected_list_comparator, free);
+  int *values = xnmalloc (nstates < ntokens ? ntokens : nstates,
+                          sizeof *values);
+  state_number s;
+  int i;
+
+  for (s = 0; s < nstates; ++s)
+    {
+      expected_list_compute (s, &lists[s]);
+      sorted[s] = &lists[s];
+    }
+  qsort (sorted, nstates, sizeof *sorted, expected_list_cmp);
+  for (s = 0; s < nstates && sorted[s]->count; ++s)
+    {
+      expected_list *l = sorted[s];
+      expected_list *w = hash_lookup (windows, l);
+      if (w)
+        l->index = w->index;
+      else
+        {
+          /* Overlap the end of EXPECTED with the beginning of L.  */
+          int overlap = l->count - 1 < nexpected ? l->count - 1 : nexpected;
+          for (/* Nothing. */; 0 < overlap; --overlap)
+            {
+              for (i = 0; i < overlap; ++i)
+                if (expected[nexpected - overlap + i] != l->tokens[i])
+                  break;
+              if (i == overlap)
+                break;
+            }
+          l->index = nexpected - overlap;
+          for (i = overlap; i < l->count; ++i)
+            {
+              expected[nexpected++] = l->tokens[i];
+              expected_windows_add (windows, expected, nexpected);
+            }
+        }
+    }
+  hash_free (windows);
+  free (sorted);
+
+  if (!nexpected)
+    expected[nexpected++] = 0;
+  muscle_insert_int_table ("expected", expected, expected[0], 1, nexpected);
+  free (expected);
+
+  for (s = 0; s < nstates; ++s)
+    values[s] = lists[s].index;
+  muscle_insert_int_table ("expected_base", values, values[0], 1, nstates);
+  for (s = 0; s < nstates; ++s)
+    values[s] = lists[s].count;
+  muscle_insert_int_table ("expected_count", values, values[0], 1, nstates);
+  free (lists);
+
+  for (i = 0; i < ntokens; ++i)
+    values[i] = tnamerr_size (symbols[i]->tag);
+  muscle_insert_int_table ("tname_size", values, values[0], 1, ntokens);
+  free (values);
+}
+
+
 /*--------------------------------------------.
 | Output the definitions of all the muscles.  |
 `--------------------------------------------*/
@@ -532,6 +875,8 @@ muscles_output (FILE *out)
   symbol_numbers_output (out);
   type_names_output (out);
   user_actions_output (out);
+  if (direct_codegen_p ())
+    direct_code_output (out);
   /* Must be last.  */
   muscles_m4_output (out);
 }
@@ -554,17 +899,33 @@ output_skeleton (void)
   char *skel = (IS_PATH_WITH_DIR (skeleton)
                 ? xstrdup (skeleton)
                 : xconcatenated_filename (datadir, skeleton, NULL));
+  char *m4frozen = NULL;
 
   /* Test whether m4sugar.m4 is readable, to check for proper
      installation.  A faulty installation can cause deadlock, so a
      cheap sanity check is worthwhile.  */
   xfclose (xfopen (m4sugar, "r"));
 
+  /* Reloading the frozen state of m4sugar saves M4 from parsing it
+     on every run.  The frozen file is produced at build time by the
+     configured M4, so don't feed it to another one.  */
+  if (feature_flag & feature_m4_frozen && STREQ (m4, M4))
+    {
+      m4frozen = xconcatenated_filename (datadir, "m4sugar/m4sugar.m4f",
+                                         NULL);
+      if (access (m4frozen, R_OK) != 0)
+        {
+          free (m4frozen);
+          m4frozen = NULL;
+        }
+    }
+
   /* Create an m4 subprocess connected to us via two pipes.  */
 
   if (trace_flag & trace_tools)
-    fprintf (stderr, "running: %s %s - %s %s\n",
-             m4, m4sugar, m4bison, skel);
+    fprintf (stderr, "running: %s %s%s - %s %s\n",
+             m4, m4frozen ? "-R " : "", m4frozen ? m4frozen : m4sugar,
+             m4bison, skel);
 
   /* Some future version of GNU M4 (most likely 1.6) may treat the -dV in a
      position-dependent manner.  Keep it as the first argument so that all
@@ -574,7 +935,7 @@ output_skeleton (void)
      <http://lists.gnu.org/archive/html/bug-bison/2008-07/msg00000.html>
      for details.  */
   {
-    char const *argv[10];
+    char const *argv[12];
     int i = 0;
     argv[i++] = m4;
 
@@ -594,7 +955,13 @@ output_skeleton (void)
     argv[i++] = datadir;
     if (trace_flag & trace_m4)
       argv[i++] = "-dV";
-    argv[i++] = m4sugar;
+    if (m4frozen)
+      {
+        argv[i++] = "-R";
+        argv[i++] = m4frozen;
+      }
+    else
+      argv[i++] = m4sugar;
     argv[i++] = "-";
     argv[i++] = m4bison;
     argv[i++] = skel;
@@ -607,6 +974,7 @@ output_skeleton (void)
   }
 
   free (m4sugar);
+  free (m4frozen);
   free (m4bison);
   free (skel);
 
@@ -697,6 +1065,8 @@ output (void)
   prepare_rules ();
   prepare_states ();
   prepare_actions ();
+  if (error_tables_p ())
+    prepare_error_tables ();
   prepare_symbol_definitions ();
 
   prepare ();
@@ -120,7 +120,7 @@ extern int gram_debug;
 
   #include "symlist.h"
   #include "symtab.h"
-#line 221 "src/parse-gram.y" /* yacc.c:372  */
+#line 223 "src/parse-gram.y" /* yacc.c:372  */
 
   typedef enum
   {
@@ -129,7 +129,7 @@ extern int gram_debug;
     param_parse  = 1 << 1,
     param_both   = param_lex | param_parse
   } param_type;
-#line 645 "src/parse-gram.y" /* yacc.c:372  */
+#line 647 "src/parse-gram.y" /* yacc.c:372  */
 #include "muscle-tab.h"
 
 #line 136 "src/parse-gram.c" /* yacc.c:372  */
@@ -203,27 +203,27 @@ extern int gram_debug;
 typedef union GRAM_STYPE GRAM_STYPE;
 union GRAM_STYPE
 {
-#line 182 "src/parse-gram.y" /* yacc.c:372  */
+#line 184 "src/parse-gram.y" /* yacc.c:372  */
 unsigned char character;
-#line 186 "src/parse-gram.y" /* yacc.c:372  */
+#line 188 "src/parse-gram.y" /* yacc.c:372  */
 char *code;
-#line 191 "src/parse-gram.y" /* yacc.c:372  */
+#line 193 "src/parse-gram.y" /* yacc.c:372  */
 uniqstr uniqstr;
-#line 199 "src/parse-gram.y" /* yacc.c:372  */
+#line 201 "src/parse-gram.y" /* yacc.c:372  */
 int integer;
-#line 203 "src/parse-gram.y" /* yacc.c:372  */
+#line 205 "src/parse-gram.y" /* yacc.c:372  */
 symbol *symbol;
-#line 208 "src/parse-gram.y" /* yacc.c:372  */
+#line 210 "src/parse-gram.y" /* yacc.c:372  */
 assoc assoc;
-#line 211 "src/parse-gram.y" /* yacc.c:372  */
+#line 213 "src/parse-gram.y" /* yacc.c:372  */
 symbol_list *list;
-#line 214 "src/parse-gram.y" /* yacc.c:372  */
+#line 216 "src/parse-gram.y" /* yacc.c:372  */
 named_ref *named_ref;
-#line 241 "src/parse-gram.y" /* yacc.c:372  */
+#line 243 "src/parse-gram.y" /* yacc.c:372  */
 param_type param;
-#line 409 "src/parse-gram.y" /* yacc.c:372  */
+#line 411 "src/parse-gram.y" /* yacc.c:372  */
 code_props_type code_type;
-#line 647 "src/parse-gram.y" /* yacc.c:372  */
+#line 649 "src/parse-gram.y" /* yacc.c:372  */
 
   struct
   {
@@ -324,7 +324,7 @@ int gram_parse (void);
   #define YYTYPE_INT8 int_fast8_t
   #define YYTYPE_UINT16 uint_fast16_t
   #define YYTYPE_UINT8 uint_fast8_t
-#line 231 "src/parse-gram.y" /* yacc.c:376  */
+#line 233 "src/parse-gram.y" /* yacc.c:376  */
 
   /** Add a lex-param and/or a parse-param.
    *
@@ -579,18 +579,18 @@ static const yytype_uint8 yytranslate[] =
   /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_uint16 yyrline[] =
 {
-       0,   264,   264,   273,   274,   278,   279,   285,   289,   294,
-     295,   300,   306,   307,   308,   309,   314,   319,   320,   321,
-     322,   323,   324,   324,   325,   326,   350,   351,   352,   353,
-     357,   358,   367,   368,   369,   373,   385,   389,   393,   401,
-     412,   413,   423,   424,   428,   440,   440,   445,   445,   450,
-     461,   476,   477,   478,   479,   483,   484,   489,   491,   496,
-     501,   511,   513,   518,   519,   523,   524,   528,   529,   530,
-     535,   540,   545,   551,   557,   568,   569,   578,   579,   585,
-     586,   587,   594,   594,   602,   603,   604,   609,   612,   614,
-     616,   618,   620,   622,   624,   629,   630,   640,   641,   666,
-     667,   668,   669,   681,   683,   692,   697,   698,   703,   711,
-     712
+       0,   266,   266,   275,   276,   280,   281,   287,   291,   296,
+     297,   302,   308,   309,   310,   311,   316,   321,   322,   323,
+     324,   325,   326,   326,   327,   328,   352,   353,   354,   355,
+     359,   360,   369,   370,   371,   375,   387,   391,   395,   403,
+     414,   415,   425,   426,   430,   442,   442,   447,   447,   452,
+     463,   478,   479,   480,   481,   485,   486,   491,   493,   498,
+     503,   513,   515,   520,   521,   525,   526,   530,   531,   532,
+     537,   542,   547,   553,   559,   570,   571,   580,   581,   587,
+     588,   589,   596,   596,   604,   605,   606,   611,   614,   616,
+     618,   620,   622,   624,   626,   631,   632,   642,   643,   668,
+     669,   670,   671,   683,   685,   694,   699,   700,   705,   713,
+     714
 };
 #endif
 
@@ -962,79 +962,79 @@ yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvalue
   switch (yytype)
     {
           case 3: /* "string"  */
-#line 188 "src/parse-gram.y" /* yacc.c:701  */
+#line 190 "src/parse-gram.y" /* yacc.c:701  */
       { fputs (quotearg_style (c_quoting_style, ((*yyvaluep).code)), yyo); }
 #line 968 "src/parse-gram.c" /* yacc.c:701  */
         break;
 
     case 23: /* "%<flag>"  */
-#line 196 "src/parse-gram.y" /* yacc.c:701  */
+#line 198 "src/parse-gram.y" /* yacc.c:701  */
       { fprintf (yyo, "%%%s", ((*yyvaluep).uniqstr)); }
 #line 974 "src/parse-gram.c" /* yacc.c:701  */
         break;
 
     case 39: /* "{...}"  */
-#line 189 "src/parse-gram.y" /* yacc.c:701  */
+#line 191 "src/parse-gram.y" /* yacc.c:701  */
       { fprintf (yyo, "{\n%s\n}", ((*yyvaluep).code)); }
 #line 980 "src/parse-gram.c" /* yacc.c:701  */
         break;
 
     case 40: /* "%?{...}"  */
-#line 189 "src/parse-gram.y" /* yacc.c:701  */
+#line 191 "src/parse-gram.y" /* yacc.c:701  */
       { fprintf (yyo, "{\n%s\n}", ((*yyvaluep).code)); }
 #line 986 "src/parse-gram.c" /* yacc.c:701  */
         break;
 
     case 41: /* "[identifier]"  */
-#line 194 "src/parse-gram.y" /* yacc.c:701  */
+#line 196 "src/parse-gram.y" /* yacc.c:701  */
       { fprintf (yyo, "[%s]", ((*yyvaluep).uniqstr)); }
 #line 992 "src/parse-gram.c" /* yacc.c:701  */
         break;
 
     case 42: /* "char"  */
-#line 184 "src/parse-gram.y" /* yacc.c:701  */
+#line 186 "src/parse-gram.y" /* yacc.c:701  */
       { fputs (char_name (((*yyvaluep).character)), yyo); }
 #line 998 "src/parse-gram.c" /* yacc.c:701  */
         break;
 
     case 43: /* "epilogue"  */
-#line 189 "src/parse-gram.y" /* yacc.c:701  */
+#line 191 "src/parse-gram.y" /* yacc.c:701  */
       { fprintf (yyo, "{\n%s\n}", ((*yyvaluep).code)); }
 #line 1004 "src/parse-gram.c" /* yacc.c:701  */
         break;
 
     case 45: /* "identifier"  */
-#line 193 "src/parse-gram.y" /* yacc.c:701  */
+#line 195 "src/parse-gram.y" /* yacc.c:701  */
       { fputs (((*yyvaluep).uniqstr), yyo); }
 #line 1010 "src/parse-gram.c" /* yacc.c:701  */
         break;
 
     case 46: /* "identifier:"  */
-#line 195 "src/parse-gram.y" /* yacc.c:701  */
+#line 197 "src/parse-gram.y" /* yacc.c:701  */
       { fprintf (yyo, "%s:", ((*yyvaluep).uniqstr)); }
 #line 1016 "src/parse-gram.c" /* yacc.c:701  */
         break;
 
     case 49: /* "%{...%}"  */
-#line 189 "src/parse-gram.y" /* yacc.c:701  */
+#line 191 "src/parse-gram.y" /* yacc.c:701  */
       { fprintf (yyo, "{\n%s\n}", ((*yyvaluep).code)); }
 #line 1022 "src/parse-gram.c" /* yacc.c:701  */
         break;
 
     case 51: /* "<tag>"  */
-#line 197 "src/parse-gram.y" /* yacc.c:701  */
+#line 199 "src/parse-gram.y" /* yacc.c:701  */
       { fprintf (yyo, "<%s>", ((*yyvaluep).uniqstr)); }
 #line 1028 "src/parse-gram.c" /* yacc.c:701  */
         break;
 
     case 54: /* "integer"  */
-#line 201 "src/parse-gram.y" /* yacc.c:701  */
+#line 203 "src/parse-gram.y" /* yacc.c:701  */
       { fprintf (yyo, "%d", ((*yyvaluep).integer)); }
 #line 1034 "src/parse-gram.c" /* yacc.c:701  */
         break;
 
     case 55: /* "%param"  */
-#line 244 "src/parse-gram.y" /* yacc.c:701  */
+#line 246 "src/parse-gram.y" /* yacc.c:701  */
       {
   switch (((*yyvaluep).param))
     {
@@ -1051,31 +1051,31 @@ yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvalue
         break;
 
     case 65: /* code_props_type  */
-#line 410 "src/parse-gram.y" /* yacc.c:701  */
+#line 412 "src/parse-gram.y" /* yacc.c:701  */
       { fprintf (yyo, "%s", code_props_type_string (((*yyvaluep).code_type))); }
 #line 1057 "src/parse-gram.c" /* yacc.c:701  */
         break;
 
     case 74: /* symbol.prec  */
-#line 205 "src/parse-gram.y" /* yacc.c:701  */
+#line 207 "src/parse-gram.y" /* yacc.c:701  */
       { fprintf (yyo, "%s", ((*yyvaluep).symbol)->tag); }
 #line 1063 "src/parse-gram.c" /* yacc.c:701  */
         break;
 
     case 78: /* tag  */
-#line 197 "src/parse-gram.y" /* yacc.c:701  */
+#line 199 "src/parse-gram.y" /* yacc.c:701  */
       { fprintf (yyo, "<%s>", ((*yyvaluep).uniqstr)); }
 #line 1069 "src/parse-gram.c" /* yacc.c:701  */
         break;
 
     case 88: /* variable  */
-#line 193 "src/parse-gram.y" /* yacc.c:701  */
+#line 195 "src/parse-gram.y" /* yacc.c:701  */
       { fputs (((*yyvaluep).uniqstr), yyo); }
 #line 1075 "src/parse-gram.c" /* yacc.c:701  */
         break;
 
     case 89: /* value  */
-#line 656 "src/parse-gram.y" /* yacc.c:701  */
+#line 658 "src/parse-gram.y" /* yacc.c:701  */
       {
   switch (((*yyvaluep).value).kind)
     {
@@ -1088,25 +1088,25 @@ yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvalue
         break;
 
     case 90: /* id  */
-#line 205 "src/parse-gram.y" /* yacc.c:701  */
+#line 207 "src/parse-gram.y" /* yacc.c:701  */
       { fprintf (yyo, "%s", ((*yyvaluep).symbol)->tag); }
 #line 1094 "src/parse-gram.c" /* yacc.c:701  */
         break;
 
     case 91: /* id_colon  */
-#line 206 "src/parse-gram.y" /* yacc.c:701  */
+#line 208 "src/parse-gram.y" /* yacc.c:701  */
       { fprintf (yyo, "%s:", ((*yyvaluep).symbol)->tag); }
 #line 1100 "src/parse-gram.c" /* yacc.c:701  */
         break;
 
     case 92: /* symbol  */
-#line 205 "src/parse-gram.y" /* yacc.c:701  */
+#line 207 "src/parse-gram.y" /* yacc.c:701  */
       { fprintf (yyo, "%s", ((*yyvaluep).symbol)->tag); }
 #line 1106 "src/parse-gram.c" /* yacc.c:701  */
         break;
 
     case 93: /* string_as_id  */
-#line 205 "src/parse-gram.y" /* yacc.c:701  */
+#line 207 "src/parse-gram.y" /* yacc.c:701  */
       { fprintf (yyo, "%s", ((*yyvaluep).symbol)->tag); }
 #line 1112 "src/parse-gram.c" /* yacc.c:701  */
         break;
@@ -1826,9 +1826,11 @@ YYLTYPE yylloc = yyloc_default;
      location is needed. */
   boundary_set (&yylloc.start, current_file, 1, 1);
   boundary_set (&yylloc.end, current_file, 1, 1);
+  /* Precedence levels are numbered afresh for each grammar.  */
+  current_prec = 0;
 }
 
-#line 1832 "src/parse-gram.c" /* yacc.c:1446  */
+#line 1834 "src/parse-gram.c" /* yacc.c:1446  */
   yylsp[0] = yylloc;
   goto yysetstate;
 
@@ -2022,143 +2024,143 @@ yyreduce:
     switch (yyn)
       {
           case 6:
-#line 280 "src/parse-gram.y" /* yacc.c:1663  */
+#line 282 "src/parse-gram.y" /* yacc.c:1663  */
     {
       muscle_code_grow (union_seen ? "post_prologue" : "pre_prologue",
                         translate_code ((yyvsp[0].code), (yylsp[0]), true), (yylsp[0]));
       code_scanner_last_string_free ();
     }
-#line 2032 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2034 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 7:
-#line 286 "src/parse-gram.y" /* yacc.c:1663  */
+#line 288 "src/parse-gram.y" /* yacc.c:1663  */
     {
       muscle_percent_define_ensure ((yyvsp[0].uniqstr), (yylsp[0]), true);
     }
-#line 2040 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2042 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 8:
-#line 290 "src/parse-gram.y" /* yacc.c:1663  */
+#line 292 "src/parse-gram.y" /* yacc.c:1663  */
     {
       muscle_percent_define_insert ((yyvsp[-1].uniqstr), (yylsp[-1]), (yyvsp[0].value).kind, (yyvsp[0].value).chars,
                                     MUSCLE_PERCENT_DEFINE_GRAMMAR_FILE);
     }
-#line 2049 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2051 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 9:
-#line 294 "src/parse-gram.y" /* yacc.c:1663  */
+#line 296 "src/parse-gram.y" /* yacc.c:1663  */
     { defines_flag = true; }
-#line 2055 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2057 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 10:
-#line 296 "src/parse-gram.y" /* yacc.c:1663  */
+#line 298 "src/parse-gram.y" /* yacc.c:1663  */
     {
       defines_flag = true;
       spec_defines_file = xstrdup ((yyvsp[0].code));
     }
-#line 2064 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2066 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 11:
-#line 301 "src/parse-gram.y" /* yacc.c:1663  */
+#line 303 "src/parse-gram.y" /* yacc.c:1663  */
     {
       muscle_percent_define_insert ("parse.error", (yylsp[0]), muscle_keyword,
                                     "verbose",
                                     MUSCLE_PERCENT_DEFINE_GRAMMAR_FILE);
     }
-#line 2074 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2076 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 12:
-#line 306 "src/parse-gram.y" /* yacc.c:1663  */
+#line 308 "src/parse-gram.y" /* yacc.c:1663  */
     { expected_sr_conflicts = (yyvsp[0].integer); }
-#line 2080 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2082 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 13:
-#line 307 "src/parse-gram.y" /* yacc.c:1663  */
+#line 309 "src/parse-gram.y" /* yacc.c:1663  */
     { expected_rr_conflicts = (yyvsp[0].integer); }
-#line 2086 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2088 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 14:
-#line 308 "src/parse-gram.y" /* yacc.c:1663  */
+#line 310 "src/parse-gram.y" /* yacc.c:1663  */
     { spec_file_prefix = (yyvsp[0].code); }
-#line 2092 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2094 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 15:
-#line 310 "src/parse-gram.y" /* yacc.c:1663  */
+#line 312 "src/parse-gram.y" /* yacc.c:1663  */
     {
       nondeterministic_parser = true;
       glr_parser = true;
     }
-#line 2101 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2103 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 16:
-#line 315 "src/parse-gram.y" /* yacc.c:1663  */
+#line 317 "src/parse-gram.y" /* yacc.c:1663  */
     {
       muscle_code_grow ("initial_action", translate_code ((yyvsp[0].code), (yylsp[0]), false), (yylsp[0]));
       code_scanner_last_string_free ();
     }
-#line 2110 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2112 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 17:
-#line 319 "src/parse-gram.y" /* yacc.c:1663  */
+#line 321 "src/parse-gram.y" /* yacc.c:1663  */
     { language_argmatch ((yyvsp[0].code), grammar_prio, (yylsp[-1])); }
-#line 2116 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2118 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 18:
-#line 320 "src/parse-gram.y" /* yacc.c:1663  */
+#line 322 "src/parse-gram.y" /* yacc.c:1663  */
     { spec_name_prefix = (yyvsp[0].code); }
-#line 2122 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2124 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 19:
-#line 321 "src/parse-gram.y" /* yacc.c:1663  */
+#line 323 "src/parse-gram.y" /* yacc.c:1663  */
     { no_lines_flag = true; }
-#line 2128 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2130 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 20:
-#line 322 "src/parse-gram.y" /* yacc.c:1663  */
+#line 324 "src/parse-gram.y" /* yacc.c:1663  */
     { nondeterministic_parser = true; }
-#line 2134 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2136 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 21:
-#line 323 "src/parse-gram.y" /* yacc.c:1663  */
+#line 325 "src/parse-gram.y" /* yacc.c:1663  */
     { spec_outfile = (yyvsp[0].code); }
-#line 2140 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2142 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 22:
-#line 324 "src/parse-gram.y" /* yacc.c:1663  */
+#line 326 "src/parse-gram.y" /* yacc.c:1663  */
     { current_param = (yyvsp[0].param); }
-#line 2146 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2148 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 23:
-#line 324 "src/parse-gram.y" /* yacc.c:1663  */
+#line 326 "src/parse-gram.y" /* yacc.c:1663  */
     { current_param = param_none; }
-#line 2152 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2154 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 24:
-#line 325 "src/parse-gram.y" /* yacc.c:1663  */
+#line 327 "src/parse-gram.y" /* yacc.c:1663  */
     { version_check (&(yylsp[0]), (yyvsp[0].code)); }
-#line 2158 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2160 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 25:
-#line 327 "src/parse-gram.y" /* yacc.c:1663  */
+#line 329 "src/parse-gram.y" /* yacc.c:1663  */
     {
       char const *skeleton_user = (yyvsp[0].code);
       if (strchr (skeleton_user, '/'))
@@ -2182,49 +2184,49 @@ yyreduce:
         }
       skeleton_arg (skeleton_user, grammar_prio, (yylsp[-1]));
     }
-#line 2186 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2188 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 26:
-#line 350 "src/parse-gram.y" /* yacc.c:1663  */
+#line 352 "src/parse-gram.y" /* yacc.c:1663  */
     { token_table_flag = true; }
-#line 2192 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2194 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 27:
-#line 351 "src/parse-gram.y" /* yacc.c:1663  */
+#line 353 "src/parse-gram.y" /* yacc.c:1663  */
     { report_flag |= report_states; }
-#line 2198 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2200 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 28:
-#line 352 "src/parse-gram.y" /* yacc.c:1663  */
+#line 354 "src/parse-gram.y" /* yacc.c:1663  */
     { yacc_flag = true; }
-#line 2204 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2206 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 30:
-#line 357 "src/parse-gram.y" /* yacc.c:1663  */
+#line 359 "src/parse-gram.y" /* yacc.c:1663  */
     { add_param (current_param, (yyvsp[0].code), (yylsp[0])); }
-#line 2210 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2212 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 31:
-#line 358 "src/parse-gram.y" /* yacc.c:1663  */
+#line 360 "src/parse-gram.y" /* yacc.c:1663  */
     { add_param (current_param, (yyvsp[0].code), (yylsp[0])); }
-#line 2216 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2218 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 34:
-#line 370 "src/parse-gram.y" /* yacc.c:1663  */
+#line 372 "src/parse-gram.y" /* yacc.c:1663  */
     {
       grammar_start_symbol_set ((yyvsp[0].symbol), (yylsp[0]));
     }
-#line 2224 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2226 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 35:
-#line 374 "src/parse-gram.y" /* yacc.c:1663  */
+#line 376 "src/parse-gram.y" /* yacc.c:1663  */
     {
       code_props code;
       code_props_symbol_action_init (&code, (yyvsp[-1].code), (yylsp[-1]));
@@ -2236,27 +2238,27 @@ yyreduce:
         symbol_list_free ((yyvsp[0].list));
       }
     }
-#line 2240 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2242 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 36:
-#line 386 "src/parse-gram.y" /* yacc.c:1663  */
+#line 388 "src/parse-gram.y" /* yacc.c:1663  */
     {
       default_prec = true;
     }
-#line 2248 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2250 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 37:
-#line 390 "src/parse-gram.y" /* yacc.c:1663  */
+#line 392 "src/parse-gram.y" /* yacc.c:1663  */
     {
       default_prec = false;
     }
-#line 2256 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2258 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 38:
-#line 394 "src/parse-gram.y" /* yacc.c:1663  */
+#line 396 "src/parse-gram.y" /* yacc.c:1663  */
     {
       /* Do not invoke muscle_percent_code_grow here since it invokes
          muscle_user_name_list_grow.  */
@@ -2264,84 +2266,84 @@ yyreduce:
                         translate_code_braceless ((yyvsp[0].code), (yylsp[0])), (yylsp[0]));
       code_scanner_last_string_free ();
     }
-#line 2268 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2270 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 39:
-#line 402 "src/parse-gram.y" /* yacc.c:1663  */
+#line 404 "src/parse-gram.y" /* yacc.c:1663  */
     {
       muscle_percent_code_grow ((yyvsp[-1].uniqstr), (yylsp[-1]), translate_code_braceless ((yyvsp[0].code), (yylsp[0])), (yylsp[0]));
       code_scanner_last_string_free ();
     }
-#line 2277 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2279 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 40:
-#line 412 "src/parse-gram.y" /* yacc.c:1663  */
+#line 414 "src/parse-gram.y" /* yacc.c:1663  */
     { (yyval.code_type) = destructor; }
-#line 2283 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2285 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 41:
-#line 413 "src/parse-gram.y" /* yacc.c:1663  */
+#line 415 "src/parse-gram.y" /* yacc.c:1663  */
     { (yyval.code_type) = printer; }
-#line 2289 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2291 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 42:
-#line 423 "src/parse-gram.y" /* yacc.c:1663  */
+#line 425 "src/parse-gram.y" /* yacc.c:1663  */
     {}
-#line 2295 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2297 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 43:
-#line 424 "src/parse-gram.y" /* yacc.c:1663  */
+#line 426 "src/parse-gram.y" /* yacc.c:1663  */
     { muscle_code_grow ("union_name", (yyvsp[0].uniqstr), (yylsp[0])); }
-#line 2301 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2303 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 44:
-#line 429 "src/parse-gram.y" /* yacc.c:1663  */
+#line 431 "src/parse-gram.y" /* yacc.c:1663  */
     {
       union_seen = true;
       muscle_code_grow ("union_members", translate_code_braceless ((yyvsp[0].code), (yylsp[0])), (yylsp[0]));
       code_scanner_last_string_free ();
     }
-#line 2311 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2313 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 45:
-#line 440 "src/parse-gram.y" /* yacc.c:1663  */
+#line 442 "src/parse-gram.y" /* yacc.c:1663  */
     { current_class = nterm_sym; }
-#line 2317 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2319 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 46:
-#line 441 "src/parse-gram.y" /* yacc.c:1663  */
+#line 443 "src/parse-gram.y" /* yacc.c:1663  */
     {
       current_class = unknown_sym;
       current_type = NULL;
     }
-#line 2326 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2328 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 47:
-#line 445 "src/parse-gram.y" /* yacc.c:1663  */
+#line 447 "src/parse-gram.y" /* yacc.c:1663  */
     { current_class = token_sym; }
-#line 2332 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2334 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 48:
-#line 446 "src/parse-gram.y" /* yacc.c:1663  */
+#line 448 "src/parse-gram.y" /* yacc.c:1663  */
     {
       current_class = unknown_sym;
       current_type = NULL;
     }
-#line 2341 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2343 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 49:
-#line 451 "src/parse-gram.y" /* yacc.c:1663  */
+#line 453 "src/parse-gram.y" /* yacc.c:1663  */
     {
       symbol_list *list;
       tag_seen = true;
@@ -2349,11 +2351,11 @@ yyreduce:
         symbol_type_set (list->content.sym, (yyvsp[-1].uniqstr), (yylsp[-1]));
       symbol_list_free ((yyvsp[0].list));
     }
-#line 2353 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2355 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 50:
-#line 462 "src/parse-gram.y" /* yacc.c:1663  */
+#line 464 "src/parse-gram.y" /* yacc.c:1663  */
     {
       symbol_list *list;
       ++current_prec;
@@ -2365,341 +2367,341 @@ yyreduce:
       symbol_list_free ((yyvsp[0].list));
       current_type = NULL;
     }
-#line 2369 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2371 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 51:
-#line 476 "src/parse-gram.y" /* yacc.c:1663  */
+#line 478 "src/parse-gram.y" /* yacc.c:1663  */
     { (yyval.assoc) = left_assoc; }
-#line 2375 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2377 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 52:
-#line 477 "src/parse-gram.y" /* yacc.c:1663  */
+#line 479 "src/parse-gram.y" /* yacc.c:1663  */
     { (yyval.assoc) = right_assoc; }
-#line 2381 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2383 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 53:
-#line 478 "src/parse-gram.y" /* yacc.c:1663  */
+#line 480 "src/parse-gram.y" /* yacc.c:1663  */
     { (yyval.assoc) = non_assoc; }
-#line 2387 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2389 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 54:
-#line 479 "src/parse-gram.y" /* yacc.c:1663  */
+#line 481 "src/parse-gram.y" /* yacc.c:1663  */
     { (yyval.assoc) = precedence_assoc; }
-#line 2393 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2395 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 55:
-#line 483 "src/parse-gram.y" /* yacc.c:1663  */
+#line 485 "src/parse-gram.y" /* yacc.c:1663  */
     { current_type = NULL; }
-#line 2399 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2401 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 56:
-#line 484 "src/parse-gram.y" /* yacc.c:1663  */
+#line 486 "src/parse-gram.y" /* yacc.c:1663  */
     { current_type = (yyvsp[0].uniqstr); tag_seen = true; }
-#line 2405 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2407 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 57:
-#line 490 "src/parse-gram.y" /* yacc.c:1663  */
+#line 492 "src/parse-gram.y" /* yacc.c:1663  */
     { (yyval.list) = symbol_list_sym_new ((yyvsp[0].symbol), (yylsp[0])); }
-#line 2411 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2413 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 58:
-#line 492 "src/parse-gram.y" /* yacc.c:1663  */
+#line 494 "src/parse-gram.y" /* yacc.c:1663  */
     { (yyval.list) = symbol_list_append ((yyvsp[-1].list), symbol_list_sym_new ((yyvsp[0].symbol), (yylsp[0]))); }
-#line 2417 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2419 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 59:
-#line 497 "src/parse-gram.y" /* yacc.c:1663  */
+#line 499 "src/parse-gram.y" /* yacc.c:1663  */
     {
       (yyval.symbol) = (yyvsp[0].symbol);
       symbol_class_set ((yyvsp[0].symbol), token_sym, (yylsp[0]), false);
     }
-#line 2426 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2428 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 60:
-#line 502 "src/parse-gram.y" /* yacc.c:1663  */
+#line 504 "src/parse-gram.y" /* yacc.c:1663  */
     {
       (yyval.symbol) = (yyvsp[-1].symbol);
       symbol_user_token_number_set ((yyvsp[-1].symbol), (yyvsp[0].integer), (yylsp[0]));
       symbol_class_set ((yyvsp[-1].symbol), token_sym, (yylsp[-1]), false);
     }
-#line 2436 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2438 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 61:
-#line 512 "src/parse-gram.y" /* yacc.c:1663  */
+#line 514 "src/parse-gram.y" /* yacc.c:1663  */
     { (yyval.list) = symbol_list_sym_new ((yyvsp[0].symbol), (yylsp[0])); }
-#line 2442 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2444 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 62:
-#line 514 "src/parse-gram.y" /* yacc.c:1663  */
+#line 516 "src/parse-gram.y" /* yacc.c:1663  */
     { (yyval.list) = symbol_list_append ((yyvsp[-1].list), symbol_list_sym_new ((yyvsp[0].symbol), (yylsp[0]))); }
-#line 2448 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2450 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 63:
-#line 518 "src/parse-gram.y" /* yacc.c:1663  */
+#line 520 "src/parse-gram.y" /* yacc.c:1663  */
     { (yyval.list) = (yyvsp[0].list); }
-#line 2454 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2456 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 64:
-#line 519 "src/parse-gram.y" /* yacc.c:1663  */
+#line 521 "src/parse-gram.y" /* yacc.c:1663  */
     { (yyval.list) = symbol_list_append ((yyvsp[-1].list), (yyvsp[0].list)); }
-#line 2460 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2462 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 65:
-#line 523 "src/parse-gram.y" /* yacc.c:1663  */
+#line 525 "src/parse-gram.y" /* yacc.c:1663  */
     { (yyval.list) = symbol_list_sym_new ((yyvsp[0].symbol), (yylsp[0])); }
-#line 2466 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2468 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 66:
-#line 524 "src/parse-gram.y" /* yacc.c:1663  */
+#line 526 "src/parse-gram.y" /* yacc.c:1663  */
     { (yyval.list) = symbol_list_type_new ((yyvsp[0].uniqstr), (yylsp[0])); }
-#line 2472 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2474 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 68:
-#line 529 "src/parse-gram.y" /* yacc.c:1663  */
+#line 531 "src/parse-gram.y" /* yacc.c:1663  */
     { (yyval.uniqstr) = uniqstr_new ("*"); }
-#line 2478 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2480 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 69:
-#line 530 "src/parse-gram.y" /* yacc.c:1663  */
+#line 532 "src/parse-gram.y" /* yacc.c:1663  */
     { (yyval.uniqstr) = uniqstr_new (""); }
-#line 2484 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2486 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 70:
-#line 536 "src/parse-gram.y" /* yacc.c:1663  */
+#line 538 "src/parse-gram.y" /* yacc.c:1663  */
     {
       current_type = (yyvsp[0].uniqstr);
       tag_seen = true;
     }
-#line 2493 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2495 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 71:
-#line 541 "src/parse-gram.y" /* yacc.c:1663  */
+#line 543 "src/parse-gram.y" /* yacc.c:1663  */
     {
       symbol_class_set ((yyvsp[0].symbol), current_class, (yylsp[0]), true);
       symbol_type_set ((yyvsp[0].symbol), current_type, (yylsp[0]));
     }
-#line 2502 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2504 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 72:
-#line 546 "src/parse-gram.y" /* yacc.c:1663  */
+#line 548 "src/parse-gram.y" /* yacc.c:1663  */
     {
       symbol_class_set ((yyvsp[-1].symbol), current_class, (yylsp[-1]), true);
       symbol_type_set ((yyvsp[-1].symbol), current_type, (yylsp[-1]));
       symbol_user_token_number_set ((yyvsp[-1].symbol), (yyvsp[0].integer), (yylsp[0]));
     }
-#line 2512 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2514 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 73:
-#line 552 "src/parse-gram.y" /* yacc.c:1663  */
+#line 554 "src/parse-gram.y" /* yacc.c:1663  */
     {
       symbol_class_set ((yyvsp[-1].symbol), current_class, (yylsp[-1]), true);
       symbol_type_set ((yyvsp[-1].symbol), current_type, (yylsp[-1]));
       symbol_make_alias ((yyvsp[-1].symbol), (yyvsp[0].symbol), (yyloc));
     }
-#line 2522 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2524 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 74:
-#line 558 "src/parse-gram.y" /* yacc.c:1663  */
+#line 560 "src/parse-gram.y" /* yacc.c:1663  */
     {
       symbol_class_set ((yyvsp[-2].symbol), current_class, (yylsp[-2]), true);
       symbol_type_set ((yyvsp[-2].symbol), current_type, (yylsp[-2]));
       symbol_user_token_number_set ((yyvsp[-2].symbol), (yyvsp[-1].integer), (yylsp[-1]));
       symbol_make_alias ((yyvsp[-2].symbol), (yyvsp[0].symbol), (yyloc));
     }
-#line 2533 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2535 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 81:
-#line 588 "src/parse-gram.y" /* yacc.c:1663  */
+#line 590 "src/parse-gram.y" /* yacc.c:1663  */
     {
       yyerrok;
     }
-#line 2541 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2543 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 82:
-#line 594 "src/parse-gram.y" /* yacc.c:1663  */
+#line 596 "src/parse-gram.y" /* yacc.c:1663  */
     { current_lhs ((yyvsp[-1].symbol), (yylsp[-1]), (yyvsp[0].named_ref)); }
-#line 2547 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2549 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 83:
-#line 595 "src/parse-gram.y" /* yacc.c:1663  */
+#line 597 "src/parse-gram.y" /* yacc.c:1663  */
     {
     /* Free the current lhs. */
     current_lhs (0, (yylsp[-3]), 0);
   }
-#line 2556 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2558 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 84:
-#line 602 "src/parse-gram.y" /* yacc.c:1663  */
+#line 604 "src/parse-gram.y" /* yacc.c:1663  */
     { grammar_current_rule_end ((yylsp[0])); }
-#line 2562 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2564 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 85:
-#line 603 "src/parse-gram.y" /* yacc.c:1663  */
+#line 605 "src/parse-gram.y" /* yacc.c:1663  */
     { grammar_current_rule_end ((yylsp[0])); }
-#line 2568 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2570 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 87:
-#line 610 "src/parse-gram.y" /* yacc.c:1663  */
+#line 612 "src/parse-gram.y" /* yacc.c:1663  */
     { grammar_current_rule_begin (current_lhs_symbol, current_lhs_location,
                                   current_lhs_named_ref); }
-#line 2575 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2577 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 88:
-#line 613 "src/parse-gram.y" /* yacc.c:1663  */
+#line 615 "src/parse-gram.y" /* yacc.c:1663  */
     { grammar_current_rule_symbol_append ((yyvsp[-1].symbol), (yylsp[-1]), (yyvsp[0].named_ref)); }
-#line 2581 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2583 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 89:
-#line 615 "src/parse-gram.y" /* yacc.c:1663  */
+#line 617 "src/parse-gram.y" /* yacc.c:1663  */
     { grammar_current_rule_action_append ((yyvsp[-1].code), (yylsp[-1]), (yyvsp[0].named_ref), false); }
-#line 2587 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2589 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 90:
-#line 617 "src/parse-gram.y" /* yacc.c:1663  */
+#line 619 "src/parse-gram.y" /* yacc.c:1663  */
     { grammar_current_rule_action_append ((yyvsp[0].code), (yylsp[0]), NULL, true); }
-#line 2593 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2595 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 91:
-#line 619 "src/parse-gram.y" /* yacc.c:1663  */
+#line 621 "src/parse-gram.y" /* yacc.c:1663  */
     { grammar_current_rule_empty_set ((yylsp[0])); }
-#line 2599 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2601 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 92:
-#line 621 "src/parse-gram.y" /* yacc.c:1663  */
+#line 623 "src/parse-gram.y" /* yacc.c:1663  */
     { grammar_current_rule_prec_set ((yyvsp[0].symbol), (yylsp[0])); }
-#line 2605 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2607 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 93:
-#line 623 "src/parse-gram.y" /* yacc.c:1663  */
+#line 625 "src/parse-gram.y" /* yacc.c:1663  */
     { grammar_current_rule_dprec_set ((yyvsp[0].integer), (yylsp[0])); }
-#line 2611 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2613 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 94:
-#line 625 "src/parse-gram.y" /* yacc.c:1663  */
+#line 627 "src/parse-gram.y" /* yacc.c:1663  */
     { grammar_current_rule_merge_set ((yyvsp[0].uniqstr), (yylsp[0])); }
-#line 2617 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2619 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 95:
-#line 629 "src/parse-gram.y" /* yacc.c:1663  */
+#line 631 "src/parse-gram.y" /* yacc.c:1663  */
     { (yyval.named_ref) = 0; }
-#line 2623 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2625 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 96:
-#line 630 "src/parse-gram.y" /* yacc.c:1663  */
+#line 632 "src/parse-gram.y" /* yacc.c:1663  */
     { (yyval.named_ref) = named_ref_new ((yyvsp[0].uniqstr), (yylsp[0])); }
-#line 2629 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2631 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 98:
-#line 641 "src/parse-gram.y" /* yacc.c:1663  */
+#line 643 "src/parse-gram.y" /* yacc.c:1663  */
     { (yyval.uniqstr) = uniqstr_new ((yyvsp[0].code)); }
-#line 2635 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2637 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 99:
-#line 666 "src/parse-gram.y" /* yacc.c:1663  */
+#line 668 "src/parse-gram.y" /* yacc.c:1663  */
     { (yyval.value).kind = muscle_keyword; (yyval.value).chars = ""; }
-#line 2641 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2643 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 100:
-#line 667 "src/parse-gram.y" /* yacc.c:1663  */
+#line 669 "src/parse-gram.y" /* yacc.c:1663  */
     { (yyval.value).kind = muscle_keyword; (yyval.value).chars = (yyvsp[0].uniqstr); }
-#line 2647 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2649 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 101:
-#line 668 "src/parse-gram.y" /* yacc.c:1663  */
+#line 670 "src/parse-gram.y" /* yacc.c:1663  */
     { (yyval.value).kind = muscle_string;  (yyval.value).chars = (yyvsp[0].code); }
-#line 2653 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2655 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 102:
-#line 669 "src/parse-gram.y" /* yacc.c:1663  */
+#line 671 "src/parse-gram.y" /* yacc.c:1663  */
     { (yyval.value).kind = muscle_code;    (yyval.value).chars = strip_braces ((yyvsp[0].code)); }
-#line 2659 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2661 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 103:
-#line 682 "src/parse-gram.y" /* yacc.c:1663  */
+#line 684 "src/parse-gram.y" /* yacc.c:1663  */
     { (yyval.symbol) = symbol_from_uniqstr ((yyvsp[0].uniqstr), (yylsp[0])); }
-#line 2665 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2667 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 104:
-#line 684 "src/parse-gram.y" /* yacc.c:1663  */
+#line 686 "src/parse-gram.y" /* yacc.c:1663  */
     {
       (yyval.symbol) = symbol_get (char_name ((yyvsp[0].character)), (yylsp[0]));
       symbol_class_set ((yyval.symbol), token_sym, (yylsp[0]), false);
       symbol_user_token_number_set ((yyval.symbol), (yyvsp[0].character), (yylsp[0]));
     }
-#line 2675 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2677 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 105:
-#line 692 "src/parse-gram.y" /* yacc.c:1663  */
+#line 694 "src/parse-gram.y" /* yacc.c:1663  */
     { (yyval.symbol) = symbol_from_uniqstr ((yyvsp[0].uniqstr), (yylsp[0])); }
-#line 2681 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2683 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 108:
-#line 704 "src/parse-gram.y" /* yacc.c:1663  */
+#line 706 "src/parse-gram.y" /* yacc.c:1663  */
     {
       (yyval.symbol) = symbol_get (quotearg_style (c_quoting_style, (yyvsp[0].code)), (yylsp[0]));
       symbol_class_set ((yyval.symbol), token_sym, (yylsp[0]), false);
     }
-#line 2690 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2692 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
   case 110:
-#line 713 "src/parse-gram.y" /* yacc.c:1663  */
+#line 715 "src/parse-gram.y" /* yacc.c:1663  */
     {
       muscle_code_grow ("epilogue", translate_code ((yyvsp[0].code), (yylsp[0]), true), (yylsp[0]));
       code_scanner_last_string_free ();
     }
-#line 2699 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2701 "src/parse-gram.c" /* yacc.c:1663  */
     break;
 
 
-#line 2703 "src/parse-gram.c" /* yacc.c:1663  */
+#line 2705 "src/parse-gram.c" /* yacc.c:1663  */
         default: break;
       }
     if (yychar_backup != yychar)
@@ -2946,7 +2948,7 @@ yyreturn:
 #endif
   return yyresult;
 }
-#line 719 "src/parse-gram.y" /* yacc.c:1923  */
+#line 721 "src/parse-gram.y" /* yacc.c:1923  */
 
 
 /* Return the location of the left-hand side of a rule whose
@@ -52,7 +52,7 @@ extern int gram_debug;
 
   #include "symlist.h"
   #include "symtab.h"
-#line 221 "src/parse-gram.y" /* yacc.c:1926  */
+#line 223 "src/parse-gram.y" /* yacc.c:1926  */
 
   typedef enum
   {
@@ -61,7 +61,7 @@ extern int gram_debug;
     param_parse  = 1 << 1,
     param_both   = param_lex | param_parse
   } param_type;
-#line 645 "src/parse-gram.y" /* yacc.c:1926  */
+#line 647 "src/parse-gram.y" /* yacc.c:1926  */
 #include "muscle-tab.h"
 
 #line 68 "src/parse-gram.h" /* yacc.c:1926  */
@@ -135,27 +135,27 @@ extern int gram_debug;
 typedef union GRAM_STYPE GRAM_STYPE;
 union GRAM_STYPE
 {
-#line 182 "src/parse-gram.y" /* yacc.c:1926  */
+#line 184 "src/parse-gram.y" /* yacc.c:1926  */
 unsigned char character;
-#line 186 "src/parse-gram.y" /* yacc.c:1926  */
+#line 188 "src/parse-gram.y" /* yacc.c:1926  */
 char *code;
-#line 191 "src/parse-gram.y" /* yacc.c:1926  */
+#line 193 "src/parse-gram.y" /* yacc.c:1926  */
 uniqstr uniqstr;
-#line 199 "src/parse-gram.y" /* yacc.c:1926  */
+#line 201 "src/parse-gram.y" /* yacc.c:1926  */
 int integer;
-#line 203 "src/parse-gram.y" /* yacc.c:1926  */
+#line 205 "src/parse-gram.y" /* yacc.c:1926  */
 symbol *symbol;
-#line 208 "src/parse-gram.y" /* yacc.c:1926  */
+#line 210 "src/parse-gram.y" /* yacc.c:1926  */
 assoc assoc;
-#line 211 "src/parse-gram.y" /* yacc.c:1926  */
+#line 213 "src/parse-gram.y" /* yacc.c:1926  */
 symbol_list *list;
-#line 214 "src/parse-gram.y" /* yacc.c:1926  */
+#line 216 "src/parse-gram.y" /* yacc.c:1926  */
 named_ref *named_ref;
-#line 241 "src/parse-gram.y" /* yacc.c:1926  */
+#line 243 "src/parse-gram.y" /* yacc.c:1926  */
 param_type param;
-#line 409 "src/parse-gram.y" /* yacc.c:1926  */
+#line 411 "src/parse-gram.y" /* yacc.c:1926  */
 code_props_type code_type;
-#line 647 "src/parse-gram.y" /* yacc.c:1926  */
+#line 649 "src/parse-gram.y" /* yacc.c:1926  */
 
   struct
   {
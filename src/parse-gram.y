@@ -110,6 +110,8 @@
      location is needed. */
   boundary_set (&@$.start, current_file, 1, 1);
   boundary_set (&@$.end, current_file, 1, 1);
+  /* Precedence levels are numbered afresh for each grammar.  */
+  current_prec = 0;
 }
 
 /* Define the tokens together with their human representation.  */
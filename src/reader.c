@@ -157,6 +157,7 @@ free_merger_functions (void)
       free (L0);
       L0 = L1;
     }
+  merge_functions = NULL;
 }
 
 
@@ -637,11 +638,21 @@ packgram (void)
 | described in gram.h.  All actions are copied into ACTION_OBSTACK, |
 | in each case forming the body of a C function (YYACTION) which    |
 | contains a switch statement to decide which action to execute.    |
+| The grammar is read from the SIZE bytes of BUF if nonnull,        |
+| otherwise from GRAMMAR_FILE.                                      |
 `------------------------------------------------------------------*/
 
 void
-reader (void)
+reader (char const *buf, size_t size)
 {
+  /* Forget about the previously read grammar, if any.  */
+  grammar = grammar_end = NULL;
+  current_rule = previous_rule_end = NULL;
+  start_flag = false;
+  union_seen = false;
+  tag_seen = false;
+  default_prec = true;
+
   /* Initialize the symbol table.  */
   symbols_new ();
 
@@ -661,24 +672,31 @@ reader (void)
   undeftoken->class = token_sym;
   undeftoken->number = ntokens++;
 
-  gram_in = xfopen (grammar_file, "r");
+  if (!buf)
+    gram_in = xfopen (grammar_file, "r");
 
   gram__flex_debug = trace_flag & trace_scan;
   gram_debug = trace_flag & trace_parse;
   gram_scanner_initialize ();
+  if (buf)
+    gram_scanner_buffer (buf, size);
   gram_parse ();
   prepare_percent_define_front_end_variables ();
 
   if (complaint_status  < status_complaint)
     check_and_convert_grammar ();
+  else
+    symbol_list_free (grammar);
 
-  xfclose (gram_in);
+  if (!buf)
+    xfclose (gram_in);
 }
 
 static void
 prepare_percent_define_front_end_variables (void)
 {
   /* Set %define front-end variable defaults.  */
+  muscle_percent_define_default ("lr.bypass-unit-rules", "false");
   muscle_percent_define_default ("lr.keep-unreachable-state", "false");
   {
     char *lr_type;
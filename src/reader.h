@@ -56,7 +56,7 @@ void grammar_current_rule_symbol_append (symbol *sym, location loc,
                                          named_ref *nref);
 void grammar_current_rule_action_append (const char *action, location loc,
                                          named_ref *nref, bool);
-void reader (void);
+void reader (char const *buf, size_t size);
 void free_merger_functions (void);
 
 extern merger_list *merge_functions;
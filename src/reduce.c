@@ -459,8 +459,11 @@ reduce_nonterminal_useless_in_grammar (symbol_number i)
 void
 reduce_free (void)
 {
+  if (!N)
+    return;
   bitset_free (N);
   bitset_free (V);
   bitset_free (V1);
   bitset_free (P);
+  N = V = V1 = P = NULL;
 }
@@ -45,71 +45,108 @@ relation_print (relation r, relation_node size, FILE *out)
 
 
 /*---------------------------------------------------------------.
-| digraph & traverse.                                            |
+| digraph.                                                       |
 |                                                                |
-| The following variables are used as common storage between the |
-| two.                                                           |
+| DeRemer and Pennello's algorithm, i.e., Tarjan's algorithm for |
+| the strongly connected components, which are completed in      |
+| reverse topological order.  The depth first traversal is       |
+| iterative, so that deep relations do not exhaust the C stack.  |
+|                                                                |
+| The rows of the members of a component are gathered along the  |
+| edges of the traversal tree into the row of its root, which is |
+| then copied to the other members: the edges to the other nodes |
+| of the component that is being traversed add nothing, and are  |
+| skipped.                                                       |
 `---------------------------------------------------------------*/
 
-static relation R;
-static relation_nodes INDEX;
-static relation_nodes VERTICES;
-static relation_node top;
-static relation_node infinity;
-static bitsetv F;
-
-static void
-traverse (relation_node i)
+/* A node being traversed.  */
+typedef struct
 {
-  relation_node j;
+  relation_node node;
+  /* Index in R[NODE] of the current edge.  */
+  relation_node edge;
+  /* Size of the stack of vertices when NODE was pushed.  */
   relation_node height;
-
-  VERTICES[++top] = i;
-  INDEX[i] = height = top;
-
-  if (R[i])
-    for (j = 0; R[i][j] != END_NODE; ++j)
-      {
-        if (INDEX[R[i][j]] == 0)
-          traverse (R[i][j]);
-
-        if (INDEX[i] > INDEX[R[i][j]])
-          INDEX[i] = INDEX[R[i][j]];
-
-        bitset_or (F[i], F[i], F[R[i][j]]);
-      }
-
-  if (INDEX[i] == height)
-    for (;;)
-      {
-        j = VERTICES[top--];
-        INDEX[j] = infinity;
-
-        if (i == j)
-          break;
-
-        bitset_copy (F[j], F[i]);
-      }
-}
-
+  /* Whether the current edge was followed by the traversal.  */
+  bool tree_edge;
+} traversal;
 
 void
 relation_digraph (relation r, relation_node size, bitsetv *function)
 {
-  relation_node i;
-
-  infinity = size + 2;
-  INDEX = xcalloc (size + 1, sizeof *INDEX);
-  VERTICES = xnmalloc (size + 1, sizeof *VERTICES);
-  top = 0;
-
-  R = r;
-  F = *function;
-
-  for (i = 0; i < size; i++)
-    if (INDEX[i] == 0 && R[i])
-      traverse (i);
+  bitsetv F = *function;
+  relation_node infinity = size + 2;
+  /* INDEX[I] -- 0 if I was not visited yet, INFINITY if its component
+     is complete, otherwise the lowest position in VERTICES of a node
+     reachable from I.  */
+  relation_nodes INDEX = xcalloc (size + 1, sizeof *INDEX);
+  relation_nodes VERTICES = xnmalloc (size + 1, sizeof *VERTICES);
+  relation_node top = 0;
+  traversal *stack = xnmalloc (size, sizeof *stack);
+  relation_node depth = 0;
+  relation_node root;
+
+  for (root = 0; root < size; root++)
+    if (INDEX[root] == 0 && r[root])
+      {
+        VERTICES[++top] = root;
+        INDEX[root] = top;
+        stack[0].node = root;
+        stack[0].edge = 0;
+        stack[0].height = top;
+        stack[0].tree_edge = false;
+        depth = 1;
+
+        while (depth)
+          {
+            traversal *t = &stack[depth - 1];
+            relation_node i = t->node;
+            relation_node j = r[i] ? r[i][t->edge] : END_NODE;
+            if (j != END_NODE)
+              {
+                if (INDEX[j] == 0)
+                  {
+                    /* Traverse J, then come back to this edge.  */
+                    t->tree_edge = true;
+                    VERTICES[++top] = j;
+                    INDEX[j] = top;
+                    stack[depth].node = j;
+                    stack[depth].edge = 0;
+                    stack[depth].height = top;
+                    stack[depth].tree_edge = false;
+                    ++depth;
+                    continue;
+                  }
+
+                if (INDEX[i] > INDEX[j])
+                  INDEX[i] = INDEX[j];
+
+                if (t->tree_edge || INDEX[j] == infinity)
+                  bitset_or (F[i], F[i], F[j]);
+
+                t->tree_edge = false;
+                ++t->edge;
+              }
+            else
+              {
+                /* I is the root of a component: complete it.  */
+                if (INDEX[i] == t->height)
+                  for (;;)
+                    {
+                      j = VERTICES[top--];
+                      INDEX[j] = infinity;
+
+                      if (i == j)
+                        break;
+
+                      bitset_copy (F[j], F[i]);
+                    }
+                --depth;
+              }
+          }
+      }
 
+  free (stack);
   free (INDEX);
   free (VERTICES);
 
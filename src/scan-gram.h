@@ -24,6 +24,7 @@
 extern FILE *gram_in;
 extern int gram__flex_debug;
 void gram_scanner_initialize (void);
+void gram_scanner_buffer (char const *buf, size_t size);
 void gram_scanner_free (void);
 void gram_scanner_last_string_free (void);
 
@@ -20,8 +20,6 @@
 #include <config.h>
 #include "system.h"
 
-#include <hash.h>
-
 #include "complain.h"
 #include "gram.h"
 #include "state.h"
@@ -123,12 +121,12 @@ state *final_state = NULL;
 
 /*------------------------------------------------------------------.
 | Create a new state with ACCESSING_SYMBOL, for those items.  Store |
-| it in the state hash table.                                       |
+| it in the state hash table, under the fingerprint FP of the core. |
 `------------------------------------------------------------------*/
 
 state *
 state_new (symbol_number accessing_symbol,
-           size_t nitems, item_number *core)
+           size_t nitems, item_number *core, core_fingerprint fp)
 {
   state *res;
   size_t items_size = nitems * sizeof *core;
@@ -149,7 +147,7 @@ state_new (symbol_number accessing_symbol,
   res->nitems = nitems;
   memcpy (res->items, core, items_size);
 
-  state_hash_insert (res);
+  state_hash_insert (res, fp);
 
   return res;
 }
@@ -300,48 +298,43 @@ state_rule_lookahead_tokens_print_xml (state *s, rule *r,
 | A state hash table.  |
 `---------------------*/
 
-/* Initial capacity of states hash table.  */
-#define HT_INITIAL_CAPACITY 257
-
-static struct hash_table *state_table = NULL;
+/* Initial capacity of states hash table, as a power of two.  */
+#define HT_INITIAL_BITS 8
 
-/* Two states are equal if they have the same core items.  */
-static inline bool
-state_compare (state const *s1, state const *s2)
+/* The states hash table uses open addressing, with linear probing.
+   Each slot records the fingerprint of the core of its state, so that
+   the items are compared only when the fingerprints are equal.  */
+typedef struct
 {
-  size_t i;
+  core_fingerprint fingerprint;
+  state *state;
+} state_slot;
 
-  if (s1->nitems != s2->nitems)
-    return false;
+static state_slot *state_table = NULL;
 
-  for (i = 0; i < s1->nitems; ++i)
-    if (s1->items[i] != s2->items[i])
-      return false;
-
-  return true;
-}
-
-static bool
-state_comparator (void const *s1, void const *s2)
-{
-  return state_compare (s1, s2);
-}
+/* STATE_TABLE has 2 ** STATE_TABLE_BITS slots, of which
+   STATE_TABLE_COUNT are used.  */
+static int state_table_bits = 0;
+static size_t state_table_count = 0;
 
+/* The first slot where to look for the fingerprint FP.  Fibonacci
+   hashing, since the low bits of FP are poorly mixed.  */
 static inline size_t
-state_hash (state const *s, size_t tablesize)
+state_slot_first (core_fingerprint fp)
 {
-  /* Add up the state's item numbers to get a hash key.  */
-  size_t key = 0;
-  size_t i;
-  for (i = 0; i < s->nitems; ++i)
-    key += s->items[i];
-  return key % tablesize;
+  return (fp * UINT64_C (0x9e3779b97f4a7c15)) >> (64 - state_table_bits);
 }
 
-static size_t
-state_hasher (void const *s, size_t tablesize)
+/* Insert S, whose core has the fingerprint FP, in a free slot.  */
+static void
+state_slot_insert (state *s, core_fingerprint fp)
 {
-  return state_hash (s, tablesize);
+  size_t mask = ((size_t) 1 << state_table_bits) - 1;
+  size_t i;
+  for (i = state_slot_first (fp); state_table[i].state; i = (i + 1) & mask)
+    continue;
+  state_table[i].fingerprint = fp;
+  state_table[i].state = s;
 }
 
 
@@ -352,11 +345,10 @@ state_hasher (void const *s, size_t tablesize)
 void
 state_hash_new (void)
 {
-  state_table = hash_initialize (HT_INITIAL_CAPACITY,
-                                 NULL,
-                                 state_hasher,
-                                 state_comparator,
-                                 NULL);
+  state_table_bits = HT_INITIAL_BITS;
+  state_table_count = 0;
+  state_table = xcalloc ((size_t) 1 << state_table_bits,
+                         sizeof *state_table);
 }
 
 
@@ -367,19 +359,35 @@ state_hash_new (void)
 void
 state_hash_free (void)
 {
-  hash_free (state_table);
+  free (state_table);
+  state_table = NULL;
 }
 
 
-/*-----------------------------------.
-| Insert S in the state hash table.  |
-`-----------------------------------*/
+/*------------------------------------------------------------.
+| Insert S, whose core has the fingerprint FP, in the state   |
+| hash table.                                                 |
+`------------------------------------------------------------*/
 
 void
-state_hash_insert (state *s)
+state_hash_insert (state *s, core_fingerprint fp)
 {
-  if (!hash_insert (state_table, s))
-    xalloc_die ();
+  /* Keep the table at most half full, so that probes stay short.  */
+  if (((size_t) 1 << state_table_bits) <= 2 * (state_table_count + 1))
+    {
+      state_slot *old = state_table;
+      size_t old_size = (size_t) 1 << state_table_bits;
+      size_t i;
+      state_table_bits++;
+      state_table = xcalloc ((size_t) 1 << state_table_bits,
+                             sizeof *state_table);
+      for (i = 0; i < old_size; ++i)
+        if (old[i].state)
+          state_slot_insert (old[i].state, old[i].fingerprint);
+      free (old);
+    }
+  state_slot_insert (s, fp);
+  state_table_count++;
 }
 
 
@@ -389,17 +397,26 @@ state_hash_insert (state *s)
 `------------------------------------------------------------------*/
 
 state *
-state_hash_lookup (size_t nitems, item_number *core)
+state_hash_lookup (size_t nitems, item_number *core, core_fingerprint fp)
 {
-  size_t items_size = nitems * sizeof *core;
-  state *probe = xmalloc (offsetof (state, items) + items_size);
-  state *entry;
-
-  probe->nitems = nitems;
-  memcpy (probe->items, core, items_size);
-  entry = hash_lookup (state_table, probe);
-  free (probe);
-  return entry;
+  size_t mask = ((size_t) 1 << state_table_bits) - 1;
+  size_t i;
+  for (i = state_slot_first (fp); state_table[i].state; i = (i + 1) & mask)
+    {
+      state *s = state_table[i].state;
+      if (state_table[i].fingerprint == fp
+          && s->nitems == nitems
+          && memcmp (s->items, core, nitems * sizeof *core) == 0)
+        return s;
+    }
+  return NULL;
+}
+
+
+void
+state_hash_prefetch (core_fingerprint fp)
+{
+  PREFETCH (&state_table[state_slot_first (fp)]);
 }
 
 
@@ -463,4 +480,7 @@ states_free (void)
   for (i = 0; i < nstates; ++i)
     state_free (states[i]);
   free (states);
+  states = NULL;
+  nstates = 0;
+  final_state = NULL;
 }
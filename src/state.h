@@ -226,9 +226,25 @@ struct state
 extern state_number nstates;
 extern state *final_state;
 
-/* Create a new state with ACCESSING_SYMBOL for those items.  */
+/* A hash of the items of a core, computed incrementally while the
+   core is built, in increasing order of items.  */
+typedef uint64_t core_fingerprint;
+
+/* The fingerprint of the empty core.  */
+# define CORE_FINGERPRINT_EMPTY UINT64_C (0xcbf29ce484222325)
+
+/* The fingerprint of the core of fingerprint FP, extended with ITEM
+   (FNV-1a, one item at a time).  */
+static inline core_fingerprint
+core_fingerprint_add (core_fingerprint fp, item_number item)
+{
+  return (fp ^ (unsigned int) item) * UINT64_C (0x100000001b3);
+}
+
+/* Create a new state with ACCESSING_SYMBOL for those items, whose
+   fingerprint is FP.  */
 state *state_new (symbol_number accessing_symbol,
-                  size_t core_size, item_number *core);
+                  size_t core_size, item_number *core, core_fingerprint fp);
 state *state_new_isocore (state const *s);
 
 /* Set the transitions of STATE.  */
@@ -252,12 +268,18 @@ void state_rule_lookahead_tokens_print_xml (state *s, rule *r,
 void state_hash_new (void);
 void state_hash_free (void);
 
-/* Find the state associated to the CORE, and return it.  If it does
-   not exist yet, return NULL.  */
-state *state_hash_lookup (size_t core_size, item_number *core);
+/* Find the state associated to the CORE, whose fingerprint is FP, and
+   return it.  If it does not exist yet, return NULL.  */
+state *state_hash_lookup (size_t core_size, item_number *core,
+                          core_fingerprint fp);
+
+/* Hint that the state whose core has the fingerprint FP is about to be
+   looked up.  */
+void state_hash_prefetch (core_fingerprint fp);
 
-/* Insert STATE in the state hash table.  */
-void state_hash_insert (state *s);
+/* Insert STATE, whose core has the fingerprint FP, in the state hash
+   table.  */
+void state_hash_insert (state *s, core_fingerprint fp);
 
 /* Remove unreachable states, renumber remaining states, update NSTATES, and
    write to OLD_TO_NEW a mapping of old state numbers to new state numbers such
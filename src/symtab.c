@@ -648,6 +648,9 @@ symbol_translation_processor (void *this, void *null ATTRIBUTE_UNUSED)
 static struct hash_table *symbol_table = NULL;
 static struct hash_table *semantic_type_table = NULL;
 
+/* Incremented for each generated dummy symbol.  */
+static int dummy_count = 0;
+
 static inline bool
 hash_compare_symbol (const symbol *m1, const symbol *m2)
 {
@@ -707,6 +710,7 @@ hash_semantic_type_hasher (void const *m, size_t tablesize)
 void
 symbols_new (void)
 {
+  dummy_count = 0;
   symbol_table = hash_initialize (HT_INITIAL_CAPACITY,
                                   NULL,
                                   hash_symbol_hasher,
@@ -803,8 +807,6 @@ semantic_type_get (const char *key, const location *loc)
 symbol *
 dummy_symbol_get (location loc)
 {
-  /* Incremented for each generated symbol.  */
-  static int dummy_count = 0;
   static char buf[256];
 
   symbol *sym;
@@ -829,11 +831,19 @@ symbol_is_dummy (const symbol *sym)
 void
 symbols_free (void)
 {
-  hash_free (symbol_table);
-  hash_free (semantic_type_table);
+  if (symbol_table)
+    {
+      hash_free (symbol_table);
+      hash_free (semantic_type_table);
+    }
+  symbol_table = semantic_type_table = NULL;
   free (symbols);
+  symbols = NULL;
   free (symbols_sorted);
+  symbols_sorted = NULL;
   free (semantic_types_sorted);
+  semantic_types_sorted = NULL;
+  errtoken = undeftoken = endtoken = accept = startsymbol = NULL;
 }
 
 
@@ -1100,6 +1110,7 @@ assoc_free (void)
       free (prec_nodes[i]);
     }
   free (prec_nodes);
+  prec_nodes = NULL;
 }
 
 /*---------------------------------------.
@@ -1173,5 +1184,6 @@ print_precedence_warnings (void)
                   _("useless associativity for %s, use %%precedence"), s->tag);
     }
   free (used_assoc);
+  used_assoc = NULL;
   assoc_free ();
 }
@@ -114,6 +114,14 @@ typedef size_t uintptr_t;
 #  define ATTRIBUTE_UNUSED __attribute__ ((__unused__))
 # endif
 
+/* Hint that the memory at Addr is about to be read.  Available in gcc
+   3.1 and later.  */
+# if 3 < __GNUC__ || (__GNUC__ == 3 && 1 <= __GNUC_MINOR__)
+#  define PREFETCH(Addr) __builtin_prefetch (Addr)
+# else
+#  define PREFETCH(Addr) ((void) 0)
+# endif
+
 
 /*------.
 | NLS.  |
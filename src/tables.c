@@ -22,6 +22,8 @@
 #include "system.h"
 
 #include <bitsetv.h>
+#include <count-trailing-zeros.h>
+#include <time.h>
 
 #include "complain.h"
 #include "conflicts.h"
@@ -132,9 +134,53 @@ base_number table_ninf = 0;
 static int lowzero;
 int high;
 
+/* TABLE_USED has the bit LOC set iff TABLE[LOC] is not 0, so that
+   pack_vector can skip used slots a word at a time.  BASE_USED has
+   the bit RES + BASE_OFFSET set iff RES is in POS, i.e., is the base
+   of a vector already packed.  They are grown along with TABLE.  */
+static bitset_word *table_used;
+static bitset_word *base_used;
+static int base_offset;
+
 state_number *yydefgoto;
 rule_number *yydefact;
 
+/*--------------------------------------------------------------.
+| The number of words of TABLE_USED and BASE_USED for a table of |
+| SIZE elements.                                                 |
+`--------------------------------------------------------------*/
+
+static size_t
+table_used_words (int size)
+{
+  return (size + BITSET_WORD_BITS - 1) / BITSET_WORD_BITS;
+}
+
+static size_t
+base_used_words (int size)
+{
+  return table_used_words (base_offset + size);
+}
+
+/*------------------------------------------------------------.
+| Grow TABLE_USED and BASE_USED from OLD_SIZE to TABLE_SIZE.  |
+`------------------------------------------------------------*/
+
+static void
+used_grow (int old_size)
+{
+  size_t old_words = table_used_words (old_size);
+  size_t words = table_used_words (table_size);
+  table_used = xnrealloc (table_used, words, sizeof *table_used);
+  memset (table_used + old_words, 0,
+          (words - old_words) * sizeof *table_used);
+
+  old_words = base_used_words (old_size);
+  words = base_used_words (table_size);
+  base_used = xnrealloc (base_used, words, sizeof *base_used);
+  memset (base_used + old_words, 0, (words - old_words) * sizeof *base_used);
+}
+
 /*-------------------------------------------------------------------.
 | If TABLE, CONFLICT_TABLE, and CHECK are too small to be addressed  |
 | at DESIRED, grow them.  TABLE[DESIRED] can be used, so the desired |
@@ -157,6 +203,7 @@ table_grow (int desired)
   conflict_table = xnrealloc (conflict_table, table_size,
                               sizeof *conflict_table);
   check = xnrealloc (check, table_size, sizeof *check);
+  used_grow (old_size);
 
   for (/* Nothing. */; old_size < table_size; ++old_size)
     {
@@ -470,6 +517,119 @@ token_actions (void)
 }
 
 
+/*-------------------------------------------------------------------.
+| Whether the code props A and B are the same (e.g., both none).     |
+`-------------------------------------------------------------------*/
+
+static bool
+code_props_same (code_props const *a, code_props const *b)
+{
+  return (a->code == b->code
+          || (a->code && b->code && STREQ (a->code, b->code)));
+}
+
+
+/*------------------------------------------------------------------.
+| Whether the reduction of R can be skipped: R is a unit rule A: X  |
+| whose default action ($$ = $1) leaves the semantic value on the   |
+| stack as is, because A and X have the same type, %destructor and  |
+| %printer.                                                         |
+`------------------------------------------------------------------*/
+
+static bool
+unit_rule_bypassable (rule const *r)
+{
+  symbol *lhs = r->lhs;
+  symbol *rhs;
+  if (rule_rhs_length (r) != 1 || r->action || r->is_predicate
+      || r->merger || r->dprec || lhs == accept)
+    return false;
+  rhs = symbols[*r->rhs];
+  return (rhs != errtoken
+          && lhs->type_name == rhs->type_name
+          && code_props_same (symbol_code_props_get (lhs, destructor),
+                              symbol_code_props_get (rhs, destructor))
+          && code_props_same (symbol_code_props_get (lhs, printer),
+                              symbol_code_props_get (rhs, printer)));
+}
+
+
+/*-----------------------------------------------------------------.
+| UNIT_REDUCTION[S] is the rule that state S always reduces, if it |
+| has no other action, and if this reduction can be skipped.       |
+`-----------------------------------------------------------------*/
+
+static rule **unit_reduction;
+
+/* The state the parser ends in when it goes from FROM to TO, and
+   performs the reductions of the unit rules that can be skipped.
+   TO if they loop.  */
+static state_number
+unit_target (state_number from, state_number to)
+{
+  state_number res = to;
+  state_number n;
+  for (n = 0; unit_reduction[res]; ++n)
+    {
+      if (n == nstates)
+        return to;
+      res = to_state[map_goto (from, unit_reduction[res]->lhs->number)];
+    }
+  return res;
+}
+
+
+/*--------------------------------------------------------------------.
+| Make the transitions that lead to a state whose only action is the  |
+| reduction of a unit rule without action (e.g., 'exp: term;') go    |
+| directly to the state this reduction leads to, so that chains of    |
+| such rules are not reduced one at a time.  Applies to the token     |
+| shifts in TOS, and to the gotos in TO_STATE, before they are        |
+| defaulted.  The states that are bypassed, and the rule numbers, are |
+| left as is.                                                         |
+`--------------------------------------------------------------------*/
+
+static void
+unit_rules_bypass (void)
+{
+  int bypassed = 0;
+  state_number s;
+  goto_number i;
+
+  unit_reduction = xnmalloc (nstates, sizeof *unit_reduction);
+  for (s = 0; s < nstates; ++s)
+    unit_reduction[s] =
+      (!tally[s] && yydefact[s]
+       && unit_rule_bypassable (&rules[yydefact[s] - 1])
+       ? &rules[yydefact[s] - 1]
+       : NULL);
+
+  for (s = 0; s < nstates; ++s)
+    {
+      size_t j;
+      for (j = 0; j < tally[s]; ++j)
+        if (0 < tos[s][j])
+          {
+            state_number to = unit_target (s, tos[s][j]);
+            bypassed += to != tos[s][j];
+            tos[s][j] = to;
+          }
+    }
+
+  for (i = 0; i < ngotos; ++i)
+    {
+      state_number to = unit_target (from_state[i], to_state[i]);
+      bypassed += to != to_state[i];
+      to_state[i] = to;
+    }
+
+  if (trace_flag & trace_tables)
+    fprintf (stderr, "tables: %d transitions bypass unit rules\n", bypassed);
+  free (unit_reduction);
+  unit_reduction = NULL;
+}
+
+
 /*------------------------------------------------------------------.
 | Compute FROMS[VECTOR], TOS[VECTOR], TALLY[VECTOR], WIDTH[VECTOR], |
 | i.e., the information related to non defaulted GOTO on the nterm  |
@@ -579,8 +739,24 @@ goto_actions (void)
 /*------------------------------------------------------------------.
 | Compute ORDER, a reordering of vectors, in order to decide how to |
 | pack the actions and gotos information into yytable.              |
+|                                                                   |
+| The widest vectors are packed first, and for a given width, the   |
+| ones with the most entries: first fit decreasing.  Equal vectors  |
+| are kept in their original order.                                 |
 `------------------------------------------------------------------*/
 
+static int
+vector_cmp (void const *a, void const *b)
+{
+  vector_number i = *(vector_number const *) a;
+  vector_number j = *(vector_number const *) b;
+  if (width[i] != width[j])
+    return width[i] < width[j] ? 1 : -1;
+  if (tally[i] != tally[j])
+    return tally[i] < tally[j] ? 1 : -1;
+  return (i > j) - (i < j);
+}
+
 static void
 sort_actions (void)
 {
@@ -590,24 +766,9 @@ sort_actions (void)
 
   for (i = 0; i < nvectors; i++)
     if (0 < tally[i])
-      {
-        int k;
-        size_t t = tally[i];
-        int w = width[i];
-        int j = nentries - 1;
+      order[nentries++] = i;
 
-        while (0 <= j && width[order[j]] < w)
-          j--;
-
-        while (0 <= j && width[order[j]] == w && tally[order[j]] < t)
-          j--;
-
-        for (k = nentries - 1; k > j; k--)
-          order[k + 1] = order[k];
-
-        order[j + 1] = i;
-        nentries++;
-      }
+  qsort (order, nentries, sizeof *order, vector_cmp);
 }
 
 
@@ -662,6 +823,44 @@ matching_state (vector_number vector)
 }
 
 
+/* The first unused slot of TABLE at or after LOC, TABLE_SIZE if
+   there is none.  */
+
+static int
+table_next_free (int loc)
+{
+  size_t nwords = table_used_words (table_size);
+  size_t w = loc / BITSET_WORD_BITS;
+  bitset_word word;
+  if (nwords <= w)
+    return table_size;
+  word = ~table_used[w] & ((bitset_word) -1 << loc % BITSET_WORD_BITS);
+  while (!word)
+    {
+      if (++w == nwords)
+        return table_size;
+      word = ~table_used[w];
+    }
+  return w * BITSET_WORD_BITS + count_trailing_zeros_l (word);
+}
+
+static bool
+bit_test (bitset_word const *map, int i)
+{
+  return (map[i / BITSET_WORD_BITS] >> i % BITSET_WORD_BITS) & 1;
+}
+
+static void
+bit_set (bitset_word *map, int i)
+{
+  map[i / BITSET_WORD_BITS] |= (bitset_word) 1 << i % BITSET_WORD_BITS;
+}
+
+
+/* Find the smallest base RES at which the entries of VECTOR fall in
+   unused slots of TABLE, and which is not the base of another vector.
+   Store the entries there, and return RES.  */
+
 static base_number
 pack_vector (vector_number vector)
 {
@@ -677,23 +876,29 @@ pack_vector (vector_number vector)
   for (res = lowzero - from[0]; ; res++)
     {
       bool ok = true;
+      /* The first entry must be in an unused slot: skip directly to
+         the next one.  */
+      {
+        int loc = table_next_free (res + state_number_as_int (from[0]));
+        if (table_size <= loc)
+          table_grow (loc);
+        res = loc - state_number_as_int (from[0]);
+      }
       aver (res < table_size);
       {
         int k;
-        for (k = 0; ok && k < t; k++)
+        for (k = 1; ok && k < t; k++)
           {
             int loc = res + state_number_as_int (from[k]);
             if (table_size <= loc)
               table_grow (loc);
 
-            if (table[loc] != 0)
+            if (bit_test (table_used, loc))
               ok = false;
           }
 
-        if (ok)
-          for (k = 0; k < vector; k++)
-            if (pos[k] == res)
-              ok = false;
+        if (ok && bit_test (base_used, res + base_offset))
+          ok = false;
       }
 
       if (ok)
@@ -704,13 +909,14 @@ pack_vector (vector_number vector)
             {
               loc = res + state_number_as_int (from[k]);
               table[loc] = to[k];
+              if (to[k] != 0)
+                bit_set (table_used, loc);
               if (nondeterministic_parser && conflict_to != NULL)
                 conflict_table[loc] = conflict_to[k];
               check[loc] = from[k];
             }
 
-          while (table[lowzero] != 0)
-            lowzero++;
+          lowzero = table_next_free (lowzero);
 
           if (high < loc)
             high = loc;
@@ -722,6 +928,96 @@ pack_vector (vector_number vector)
 }
 
 
+/*-------------------------------------------------------------------.
+| Pack the vectors again with the former algorithm, which probes     |
+| every base and compares it to all the previous ones, and check     |
+| that it gives the same bases and table as pack_vector.  Return the |
+| time it took.  Used by --trace=tables.                             |
+`-------------------------------------------------------------------*/
+
+static double
+pack_table_former (void)
+{
+  clock_t start = clock ();
+  int size = table_size;
+  base_number *ftable = xcalloc (size, sizeof *ftable);
+  base_number *fbase = xnmalloc (nvectors, sizeof *fbase);
+  base_number *fpos = xnmalloc (nentries, sizeof *fpos);
+  int flowzero = 0;
+  int fhigh = 0;
+  double res;
+  int i;
+
+  for (i = 0; i < nvectors; i++)
+    fbase[i] = BASE_MINIMUM;
+
+  for (i = 0; i < nentries; i++)
+    {
+      state_number s = matching_state (i);
+      vector_number v = order[i];
+      size_t t = tally[v];
+      base_number place;
+
+      if (0 <= s)
+        place = fbase[s];
+      else
+        for (place = flowzero - froms[v][0]; ; place++)
+          {
+            bool ok = true;
+            int k;
+            for (k = 0; ok && k < t; k++)
+              {
+                int loc = place + state_number_as_int (froms[v][k]);
+                if (size <= loc)
+                  {
+                    int old_size = size;
+                    while (size <= loc)
+                      size *= 2;
+                    ftable = xnrealloc (ftable, size, sizeof *ftable);
+                    memset (ftable + old_size, 0,
+                            (size - old_size) * sizeof *ftable);
+                  }
+                if (ftable[loc] != 0)
+                  ok = false;
+              }
+
+            for (k = 0; ok && k < i; k++)
+              if (fpos[k] == place)
+                ok = false;
+
+            if (ok)
+              {
+                for (k = 0; k < t; k++)
+                  {
+                    int loc = place + state_number_as_int (froms[v][k]);
+                    ftable[loc] = tos[v][k];
+                    if (fhigh < loc)
+                      fhigh = loc;
+                  }
+                while (ftable[flowzero] != 0)
+                  flowzero++;
+                break;
+              }
+          }
+
+      fpos[i] = place;
+      fbase[v] = place;
+    }
+  res = (double) (clock () - start) / CLOCKS_PER_SEC;
+
+  aver (fhigh == high);
+  for (i = 0; i < nvectors; i++)
+    aver (fbase[i] == base[i]);
+  for (i = 0; i <= high; i++)
+    aver (ftable[i] == table[i]);
+
+  free (ftable);
+  free (fbase);
+  free (fpos);
+  return res;
+}
+
+
 /*-------------------------------------------------------------.
 | Remap the negative infinite in TAB from NINF to the greatest |
 | possible smallest value.  Return it.                         |
@@ -753,6 +1049,8 @@ static void
 pack_table (void)
 {
   int i;
+  int shared = 0;
+  clock_t start = clock ();
 
   base = xnmalloc (nvectors, sizeof *base);
   pos = xnmalloc (nentries, sizeof *pos);
@@ -760,6 +1058,12 @@ pack_table (void)
   conflict_table = xcalloc (table_size, sizeof *conflict_table);
   check = xnmalloc (table_size, sizeof *check);
 
+  /* The bases are greater than minus the greatest symbol or state
+     number.  */
+  base_offset = state_number_as_int (nstates) + nsyms;
+  table_used = xcalloc (table_used_words (table_size), sizeof *table_used);
+  base_used = xcalloc (base_used_words (table_size), sizeof *base_used);
+
   lowzero = 0;
   high = 0;
 
@@ -778,18 +1082,41 @@ pack_table (void)
         /* A new set of state actions, or a nonterminal.  */
         place = pack_vector (i);
       else
-        /* Action of I were already coded for S.  */
-        place = base[s];
+        {
+          /* Action of I were already coded for S.  */
+          place = base[s];
+          ++shared;
+        }
 
       pos[i] = place;
+      bit_set (base_used, place + base_offset);
       base[order[i]] = place;
     }
 
+  if (trace_flag & trace_tables)
+    {
+      int nused = 0;
+      double elapsed = (double) (clock () - start) / CLOCKS_PER_SEC;
+      for (i = 0; i <= high; i++)
+        nused += check[i] != -1;
+      fprintf (stderr,
+               "tables: %d vectors, %d packed, %d shared,"
+               " %d slots, %d used, %.3fs\n",
+               nvectors, nentries - shared, shared, high + 1, nused, elapsed);
+      /* Check against the former packing, and compare the times.  */
+      fprintf (stderr, "tables: former packing: same tables, %.3fs\n",
+               pack_table_former ());
+    }
+
   /* Use the greatest possible negative infinites.  */
   base_ninf = table_ninf_remap (base, nvectors, BASE_MINIMUM);
   table_ninf = table_ninf_remap (table, high + 1, ACTION_NUMBER_MINIMUM);
 
   free (pos);
+  free (table_used);
+  table_used = NULL;
+  free (base_used);
+  base_used = NULL;
 }
 
 
@@ -819,6 +1146,8 @@ tables_generate (void)
   width = xnmalloc (nvectors, sizeof *width);
 
   token_actions ();
+  if (muscle_percent_define_flag_if ("lr.bypass-unit-rules"))
+    unit_rules_bypass ();
 
   goto_actions ();
   free (goto_map);
@@ -854,10 +1183,18 @@ void
 tables_free (void)
 {
   free (base);
+  base = NULL;
   free (conflict_table);
+  conflict_table = NULL;
   free (conflict_list);
+  conflict_list = NULL;
   free (table);
+  table = NULL;
   free (check);
+  check = NULL;
   free (yydefgoto);
+  yydefgoto = NULL;
   free (yydefact);
+  yydefact = NULL;
+  table_size = 32768;
 }
@@ -0,0 +1,212 @@
+/* Tests of the library interface to Bison.
+
+   Copyright (C) 2013 Free Software Foundation, Inc.
+
+   This file is part of Bison, the GNU Compiler Compiler.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include <config.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bison-api.h"
+
+static int failures = 0;
+
+#define CHECK(Cond)                                             \
+  do {                                                          \
+    if (!(Cond))                                                \
+      {                                                         \
+        fprintf (stderr, "%s:%d: check failed: %s\n",           \
+                 __FILE__, __LINE__, #Cond);                    \
+        ++failures;                                             \
+      }                                                         \
+  } while (0)
+
+enum { NUM = 258 };
+
+static char const calc[] =
+  "%token NUM\n"
+  "%left '+' '-'\n"
+  "%left '*'\n"
+  "%%\n"
+  "exp: exp '+' exp | exp '-' exp | exp '*' exp | '(' exp ')' | NUM;\n";
+
+static char const list[] =
+  "%define lr.type canonical-lr\n"
+  "%%\n"
+  "list: %empty | list 'a';\n";
+
+static int
+compile (bison_context *ctx, char const *name, char const *grammar)
+{
+  return bison_compile (ctx, name, grammar, strlen (grammar));
+}
+
+/* Whether the parser of CTX accepts TOKENS, user token numbers ending
+   with 0.  This is the yacc.c parser, without its semantic values.  */
+static bool
+parse (bison_context const *ctx, int const *tokens)
+{
+  int const *pact = bison_table (ctx, bison_table_pact, NULL);
+  int const *pgoto = bison_table (ctx, bison_table_pgoto, NULL);
+  int const *defact = bison_table (ctx, bison_table_defact, NULL);
+  int const *defgoto = bison_table (ctx, bison_table_defgoto, NULL);
+  int const *table = bison_table (ctx, bison_table_table, NULL);
+  int const *check = bison_table (ctx, bison_table_check, NULL);
+  int const *r1 = bison_table (ctx, bison_table_r1, NULL);
+  int const *r2 = bison_table (ctx, bison_table_r2, NULL);
+  int const *translate = bison_table (ctx, bison_table_translate, NULL);
+  int final = bison_value (ctx, bison_value_final);
+  int last = bison_value (ctx, bison_value_last);
+  int ntokens = bison_value (ctx, bison_value_ntokens);
+  int maxutok = bison_value (ctx, bison_value_maxutok);
+  int pact_ninf = bison_value (ctx, bison_value_pact_ninf);
+  int table_ninf = bison_value (ctx, bison_value_table_ninf);
+  int stack[100];
+  int top = 0;
+
+  stack[0] = 0;
+  while (stack[top] != final)
+    {
+      int yyn = pact[stack[top]];
+      int lhs;
+      if (yyn != pact_ninf)
+        {
+          int token = *tokens <= maxutok ? translate[*tokens] : 2;
+          yyn += token;
+          if (0 <= yyn && yyn <= last && check[yyn] == token)
+            {
+              yyn = table[yyn];
+              if (0 < yyn)
+                {
+                  if (top + 1 == sizeof stack / sizeof *stack)
+                    return false;
+                  stack[++top] = yyn;
+                  ++tokens;
+                  continue;
+                }
+              if (yyn == table_ninf)
+                return false;
+              yyn = -yyn;
+              goto reduce;
+            }
+        }
+      yyn = defact[stack[top]];
+      if (!yyn)
+        return false;
+    reduce:
+      top -= r2[yyn];
+      lhs = r1[yyn] - ntokens;
+      yyn = pgoto[lhs] + stack[top];
+      yyn = (0 <= yyn && yyn <= last && check[yyn] == stack[top]
+             ? table[yyn]
+             : defgoto[lhs]);
+      stack[++top] = yyn;
+    }
+  return true;
+}
+
+static void
+test_tables (void)
+{
+  bison_context *ctx = bison_context_new ();
+  size_t size;
+
+  CHECK (compile (ctx, "calc.y", calc) == 0);
+  CHECK (bison_value (ctx, bison_value_nrules) == 6);
+  CHECK (bison_value (ctx, bison_value_ntokens) == 9);
+  CHECK (bison_value (ctx, bison_value_nnts) == 2);
+  CHECK (bison_value (ctx, bison_value_maxutok) == NUM);
+
+  CHECK (bison_table (ctx, bison_table_pact, &size) && size
+         == (size_t) bison_value (ctx, bison_value_nstates));
+  CHECK (bison_table (ctx, bison_table_defact, &size) && size
+         == (size_t) bison_value (ctx, bison_value_nstates));
+  CHECK (bison_table (ctx, bison_table_pgoto, &size) && size == 2);
+  CHECK (bison_table (ctx, bison_table_defgoto, &size) && size == 2);
+  CHECK (bison_table (ctx, bison_table_table, &size) && size
+         == (size_t) bison_value (ctx, bison_value_last) + 1);
+  CHECK (bison_table (ctx, bison_table_check, &size) && size
+         == (size_t) bison_value (ctx, bison_value_last) + 1);
+  CHECK (bison_table (ctx, bison_table_r1, &size) && size == 7);
+  CHECK (bison_table (ctx, bison_table_r2, &size) && size == 7);
+  CHECK (bison_table (ctx, bison_table_translate, &size) && size == NUM + 1);
+
+  /* exp: exp '*' exp.  */
+  CHECK (bison_table (ctx, bison_table_r2, NULL)[4] == 3);
+  bison_context_free (ctx);
+}
+
+static void
+test_parse (void)
+{
+  static int const ok1[] = { NUM, 0 };
+  static int const ok2[] = { NUM, '+', NUM, '*', '(', NUM, '-', NUM, ')', 0 };
+  static int const ko1[] = { NUM, '+', 0 };
+  static int const ko2[] = { '(', NUM, 0 };
+  static int const ko3[] = { 0 };
+  static int const list1[] = { 0 };
+  static int const list2[] = { 'a', 'a', 'a', 0 };
+  bison_context *ctx1 = bison_context_new ();
+  bison_context *ctx2 = bison_context_new ();
+
+  CHECK (compile (ctx1, "calc.y", calc) == 0);
+  CHECK (compile (ctx2, "list.y", list) == 0);
+
+  /* The results of a context are independent of the others.  */
+  CHECK (parse (ctx1, ok1));
+  CHECK (parse (ctx1, ok2));
+  CHECK (!parse (ctx1, ko1));
+  CHECK (!parse (ctx1, ko2));
+  CHECK (!parse (ctx1, ko3));
+  CHECK (parse (ctx2, list1));
+  CHECK (parse (ctx2, list2));
+  CHECK (!parse (ctx2, ok1));
+
+  bison_context_free (ctx1);
+  bison_context_free (ctx2);
+}
+
+static void
+test_errors (void)
+{
+  static char const bad[] = "%%\nexp: '+' %prec;\n";
+  bison_context *ctx = bison_context_new ();
+  size_t size = 1;
+
+  CHECK (compile (ctx, "calc.y", calc) == 0);
+  fputs ("expect an error on bad.y:\n", stderr);
+  CHECK (compile (ctx, "bad.y", bad) != 0);
+  CHECK (!bison_table (ctx, bison_table_pact, &size) && size == 0);
+  CHECK (bison_value (ctx, bison_value_nstates) == 0);
+
+  /* Errors leave no trace.  */
+  CHECK (compile (ctx, "calc.y", calc) == 0);
+  CHECK (bison_table (ctx, bison_table_pact, NULL));
+  bison_context_free (ctx);
+}
+
+int
+main (void)
+{
+  test_tables ();
+  test_parse ();
+  test_errors ();
+  return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
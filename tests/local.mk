@@ -78,6 +78,16 @@ $(TESTSUITE): $(TESTSUITE_AT)
 	$(AM_V_at)mv $@.tmp $@
 
 
+## ----------------- ##
+## The library API.  ##
+## ----------------- ##
+
+check_PROGRAMS += tests/api
+tests_api_CPPFLAGS = $(AM_CPPFLAGS) -I$(top_srcdir)/src
+tests_api_LDADD = src/libbison-api.a $(LDADD)
+TESTS += tests/api
+
+
 ## -------------------- ##
 ## Run the test suite.  ##
 ## -------------------- ##